@@ -0,0 +1,59 @@
+#include "./harness.hpp"
+
+#include <parsers/parsers.hpp>
+
+#include <string>
+#include <vector>
+
+namespace {
+using namespace parsers::description;
+
+using key = as_range<many1<ascii::alnum_t>>;
+using value = as_range<many<ascii::alnum_t>>;
+using key_value = sequence<key, discard<character<'='>>, value>;
+
+const std::vector<std::string>& inputs() {
+  static const std::vector<std::string> lines = [] {
+    std::vector<std::string> result;
+    for (int i = 0; i < 1024; ++i) {
+      result.push_back("key" + std::to_string(i) + "=value" +
+                       std::to_string(i * 7));
+    }
+    return result;
+  }();
+  return lines;
+}
+
+void parse_each(std::size_t iterations) {
+  for (std::size_t i = 0; i < iterations; ++i) {
+    for (const auto& line : inputs()) {
+      parsers_bench::do_not_optimize(parsers::parse(key_value{}, line));
+    }
+  }
+}
+
+void prepared_each(std::size_t iterations) {
+  const auto prepared = parsers::prepare(key_value{});
+  for (std::size_t i = 0; i < iterations; ++i) {
+    for (const auto& line : inputs()) {
+      parsers_bench::do_not_optimize(prepared(line));
+    }
+  }
+}
+
+void prepared_batch(std::size_t iterations) {
+  const auto prepared = parsers::prepare(key_value{});
+  using result_t = decltype(parsers::parse(key_value{}, inputs().front()));
+  std::vector<result_t> out;
+  for (std::size_t i = 0; i < iterations; ++i) {
+    parsers_bench::do_not_optimize(
+        parsers::parse_batch(prepared, inputs(), out));
+  }
+}
+
+const parsers_bench::registration registrations[] = {
+    {"batch/parse_each/1024_lines", &parse_each},
+    {"batch/prepared_each/1024_lines", &prepared_each},
+    {"batch/parse_batch/1024_lines", &prepared_batch},
+};
+}  // namespace
@@ -0,0 +1,282 @@
+// Measures the time and peak memory the compiler needs to instantiate the
+// interpreters over generated grammars of increasing size, so that
+// regressions in the metaprogramming show up before they reach real grammars.
+//
+// Usage: parsers_compile_bench [--json=FILE] [--baseline=FILE]
+//                              [--tolerance=RATIO] [--max-size=N]
+//                              [--work-dir=DIR] [FILTER] [-- FLAGS...]
+// FLAGS are passed to the compiler after the default ones. With --baseline,
+// the results are compared to those of an earlier --json run and the program
+// fails if one of them grew by more than RATIO (1.25 by default).
+
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace {
+
+struct grammar {
+  std::string name;
+  std::string definition;  // declares `grammar`
+};
+
+std::string keyword(std::size_t i) {
+  std::string result = "sequence<character<'k'>";
+  for (const char c : std::to_string(i)) {
+    result += ", character<'";
+    result += c;
+    result += "'>";
+  }
+  return result + ">";
+}
+
+grammar alternatives(std::size_t n) {
+  std::string result = "using grammar = alternative<";
+  for (std::size_t i = 0; i < n; ++i) {
+    result += i == 0 ? "\n    " : ",\n    ";
+    result += keyword(i);
+  }
+  return {"alternative/" + std::to_string(n), result + ">;\n"};
+}
+
+grammar sequences(std::size_t n) {
+  constexpr const char* elements[] = {"discard<character<','>>",
+                                      "ascii::digit_t",
+                                      "as_range<many1<ascii::alpha_t>>"};
+  std::string result = "using grammar = sequence<";
+  for (std::size_t i = 0; i < n; ++i) {
+    result += i == 0 ? "\n    " : ",\n    ";
+    result += elements[i % 3];
+  }
+  return {"sequence/" + std::to_string(n), result + ">;\n"};
+}
+
+grammar nesting(std::size_t depth) {
+  std::string result = "using level0 = ascii::digit_t;\n";
+  for (std::size_t i = 1; i <= depth; ++i) {
+    result += "using level" + std::to_string(i) +
+              " = sequence<character<'('>, many<alternative<ascii::digit_t, "
+              "level" +
+              std::to_string(i - 1) + ">>, character<')'>>;\n";
+  }
+  return {"nesting/" + std::to_string(depth),
+          result + "using grammar = level" + std::to_string(depth) + ";\n"};
+}
+
+std::vector<grammar> grammars(std::size_t max_size) {
+  std::vector<grammar> result{{"baseline", "using grammar = character<'a'>;\n"}};
+  for (std::size_t n = 4; n <= max_size; n *= 2) {
+    result.push_back(alternatives(n));
+  }
+  for (std::size_t n = 4; n <= max_size; n *= 2) {
+    result.push_back(sequences(n));
+  }
+  for (std::size_t d = 2; d <= max_size / 4; d *= 2) {
+    result.push_back(nesting(d));
+  }
+  return result;
+}
+
+std::string source(const grammar& g) {
+  return "#include <parsers/parsers.hpp>\n"
+         "\n"
+         "#include <string_view>\n"
+         "\n"
+         "using namespace parsers::description;\n" +
+         g.definition +
+         "\n"
+         "bool instantiate(std::string_view input) {\n"
+         "  return parsers::match(grammar{}, input) &&\n"
+         "         parsers::parse_range(grammar{}, input).has_value() &&\n"
+         "         parsers::parse(grammar{}, input).has_value();\n"
+         "}\n";
+}
+
+struct measurement {
+  std::string name;
+  double seconds;
+  long peak_kib;
+};
+
+// Runs the compiler in a child process to get its own resource usage.
+bool compile(const std::vector<std::string>& command,
+             const std::string& log,
+             measurement& out) {
+  std::vector<char*> argv;
+  for (const auto& arg : command) {
+    argv.push_back(const_cast<char*>(arg.c_str()));
+  }
+  argv.push_back(nullptr);
+
+  const auto start = std::chrono::steady_clock::now();
+  const pid_t pid = fork();
+  if (pid < 0) {
+    return false;
+  }
+  if (pid == 0) {
+    const int fd = open(log.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd >= 0) {
+      dup2(fd, STDOUT_FILENO);
+      dup2(fd, STDERR_FILENO);
+    }
+    execvp(argv[0], argv.data());
+    _exit(127);
+  }
+  int status = 0;
+  rusage usage{};
+  if (wait4(pid, &status, 0, &usage) < 0) {
+    return false;
+  }
+  out.seconds = std::chrono::duration<double>(
+                    std::chrono::steady_clock::now() - start)
+                    .count();
+#if defined(__APPLE__)
+  out.peak_kib = usage.ru_maxrss / 1024;
+#else
+  out.peak_kib = usage.ru_maxrss;
+#endif
+  return WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+void write_json(std::ostream& out, const std::vector<measurement>& results) {
+  out.precision(12);
+  out << "[";
+  const char* separator = "\n";
+  for (const auto& m : results) {
+    out << separator << "  {\"name\": \"" << m.name
+        << "\", \"seconds\": " << m.seconds
+        << ", \"peak_kib\": " << m.peak_kib << "}";
+    separator = ",\n";
+  }
+  out << "\n]\n";
+}
+
+// Reads back the output of `write_json`, one measurement per line.
+std::map<std::string, measurement> read_json(const std::string& path) {
+  std::map<std::string, measurement> result;
+  std::ifstream in{path};
+  std::string line;
+  while (std::getline(in, line)) {
+    const auto name = line.find("\"name\": \"");
+    const auto seconds = line.find("\"seconds\": ");
+    const auto peak = line.find("\"peak_kib\": ");
+    if (name == std::string::npos || seconds == std::string::npos ||
+        peak == std::string::npos) {
+      continue;
+    }
+    measurement m;
+    const auto first = name + 9;
+    m.name = line.substr(first, line.find('"', first) - first);
+    m.seconds = std::strtod(line.c_str() + seconds + 11, nullptr);
+    m.peak_kib = std::strtol(line.c_str() + peak + 12, nullptr, 10);
+    result[m.name] = m;
+  }
+  return result;
+}
+
+}  // namespace
+
+int main(int argc, const char** argv) {
+  std::string filter;
+  std::string json_path;
+  std::string baseline_path;
+  std::string work_dir = ".";
+  double tolerance = 1.25;
+  std::size_t max_size = 64;
+  std::vector<std::string> flags;
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view arg = argv[i];
+    if (arg == "--") {
+      flags.assign(argv + i + 1, argv + argc);
+      break;
+    }
+    if (arg.substr(0, 7) == "--json=") {
+      json_path = arg.substr(7);
+    }
+    else if (arg.substr(0, 11) == "--baseline=") {
+      baseline_path = arg.substr(11);
+    }
+    else if (arg.substr(0, 12) == "--tolerance=") {
+      tolerance = std::strtod(argv[i] + 12, nullptr);
+    }
+    else if (arg.substr(0, 11) == "--max-size=") {
+      max_size = std::strtoull(argv[i] + 11, nullptr, 10);
+    }
+    else if (arg.substr(0, 11) == "--work-dir=") {
+      work_dir = arg.substr(11);
+    }
+    else {
+      filter = arg;
+    }
+  }
+
+  const auto baseline = baseline_path.empty()
+                            ? std::map<std::string, measurement>{}
+                            : read_json(baseline_path);
+  std::vector<measurement> results;
+  bool regressed = false;
+  for (const auto& g : grammars(max_size)) {
+    if (g.name.find(filter) == std::string::npos) {
+      continue;
+    }
+    std::string stem = g.name;
+    for (auto& c : stem) {
+      c = c == '/' ? '_' : c;
+    }
+    const auto path = work_dir + "/compile_time_" + stem + ".cpp";
+    std::ofstream{path} << source(g);
+
+    std::vector<std::string> command{PARSERS_BENCH_CXX,
+                                     PARSERS_BENCH_STD,
+                                     "-I" PARSERS_BENCH_INCLUDE,
+                                     "-fsyntax-only"};
+    command.insert(command.end(), flags.begin(), flags.end());
+    command.push_back(path);
+
+    measurement m{g.name, 0, 0};
+    if (!compile(command, path + ".log", m)) {
+      std::fprintf(stderr,
+                   "%s: compilation failed, see %s.log\n",
+                   g.name.c_str(),
+                   path.c_str());
+      return 1;
+    }
+    std::printf("%-24s %10.3f s %12ld KiB", m.name.c_str(), m.seconds,
+                m.peak_kib);
+    if (const auto it = baseline.find(m.name); it != baseline.end()) {
+      const double time_ratio = m.seconds / it->second.seconds;
+      const double memory_ratio = static_cast<double>(m.peak_kib) /
+                                  static_cast<double>(it->second.peak_kib);
+      std::printf("  x%.2f time  x%.2f memory", time_ratio, memory_ratio);
+      if (time_ratio > tolerance || memory_ratio > tolerance) {
+        std::printf("  REGRESSION");
+        regressed = true;
+      }
+    }
+    std::printf("\n");
+    results.push_back(m);
+  }
+
+  if (!json_path.empty()) {
+    std::ofstream out{json_path};
+    write_json(out, results);
+    if (!out) {
+      std::fprintf(stderr, "could not write %s\n", json_path.c_str());
+      return 1;
+    }
+  }
+
+  return regressed ? 1 : 0;
+}
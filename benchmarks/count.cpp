@@ -0,0 +1,71 @@
+#include "./harness.hpp"
+
+#include <parsers/parsers.hpp>
+
+#include <string>
+
+namespace {
+using namespace parsers::description;
+
+constexpr std::size_t input_size = std::size_t{1} << 16U;
+
+const std::string& digits_input() {
+  static const std::string text(input_size, '7');
+  return text;
+}
+
+const std::string& csv_input() {
+  static const std::string text = [] {
+    std::string result;
+    for (std::size_t i = 0; result.size() < input_size; ++i) {
+      result += std::to_string(i * 7919) + ",abc," + std::to_string(i) + "\n";
+    }
+    result.resize(input_size);
+    return result;
+  }();
+  return text;
+}
+
+void leading_many(std::size_t iterations) {
+  for (std::size_t i = 0; i < iterations; ++i) {
+    parsers_bench::do_not_optimize(
+        parsers::parse(many<ascii::digit_t>{}, digits_input())->size());
+  }
+}
+
+void leading_match(std::size_t iterations) {
+  for (std::size_t i = 0; i < iterations; ++i) {
+    parsers_bench::do_not_optimize(
+        parsers::match_length(many<ascii::digit_t>{}, digits_input()));
+  }
+}
+
+void leading_count(std::size_t iterations) {
+  for (std::size_t i = 0; i < iterations; ++i) {
+    parsers_bench::do_not_optimize(
+        parsers::count(ascii::digit, digits_input()));
+  }
+}
+
+void all_characters(std::size_t iterations) {
+  for (std::size_t i = 0; i < iterations; ++i) {
+    parsers_bench::do_not_optimize(
+        parsers::count_all(character<','>{}, csv_input()));
+  }
+}
+
+void all_numbers(std::size_t iterations) {
+  for (std::size_t i = 0; i < iterations; ++i) {
+    parsers_bench::do_not_optimize(
+        parsers::count_all(many1<ascii::digit_t>{}, csv_input()));
+  }
+}
+
+const parsers_bench::registration registrations[] = {
+    {"count/leading/many", &leading_many, input_size},
+    {"count/leading/match", &leading_match, input_size},
+    {"count/leading/count", &leading_count, input_size},
+    {"count/all/characters", &all_characters, input_size},
+    {"count/all/numbers", &all_numbers, input_size},
+};
+}  // namespace
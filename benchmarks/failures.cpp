@@ -0,0 +1,99 @@
+#include "./harness.hpp"
+
+#include <parsers/parsers.hpp>
+#include <parsers/furthest_failure.hpp>
+
+#include <string>
+
+namespace {
+using namespace parsers::description;
+
+constexpr std::size_t input_size = std::size_t{1} << 16U;
+
+using number = many1<ascii::digit_t>;
+using record = sequence<number,
+                        discard<character<','>>,
+                        number,
+                        discard<character<'\n'>>>;
+using records = sequence<many<record>, end_t>;
+
+const std::string& valid_input() {
+  static const std::string text = [] {
+    std::string result;
+    for (std::size_t i = 0; result.size() < input_size; ++i) {
+      result += std::to_string(i * 7919) + "," + std::to_string(i) + "\n";
+    }
+    return result;
+  }();
+  return text;
+}
+
+// Fails on the last record, after the whole input has been tried.
+const std::string& invalid_input() {
+  static const std::string text = [] {
+    std::string result = valid_input();
+    result[result.size() - 2] = ';';
+    return result;
+  }();
+  return text;
+}
+
+template <class Interpreter, bool Enabled>
+void run(const std::string& input, std::size_t iterations) {
+  parsers::furthest_failure failure;
+  const auto parser =
+      parsers::make_failure_tracking_parser<Interpreter, Enabled>(records{},
+                                                                  failure);
+  for (std::size_t i = 0; i < iterations; ++i) {
+    failure.clear();
+    parsers_bench::do_not_optimize(
+        parser(input.data(), input.data() + input.size()).has_value());
+    parsers_bench::do_not_optimize(failure.remaining());
+  }
+}
+
+void plain_valid(std::size_t iterations) {
+  const auto parser =
+      parsers::interpreters::make_parser<parsers::interpreters::range_parser>(
+          records{});
+  const auto& input = valid_input();
+  for (std::size_t i = 0; i < iterations; ++i) {
+    parsers_bench::do_not_optimize(
+        parser(input.data(), input.data() + input.size()).has_value());
+  }
+}
+
+void disabled_valid(std::size_t iterations) {
+  run<parsers::interpreters::range_parser, false>(valid_input(), iterations);
+}
+
+void tracking_valid(std::size_t iterations) {
+  run<parsers::interpreters::range_parser, true>(valid_input(), iterations);
+}
+
+void disabled_invalid(std::size_t iterations) {
+  run<parsers::interpreters::range_parser, false>(invalid_input(), iterations);
+}
+
+void tracking_invalid(std::size_t iterations) {
+  run<parsers::interpreters::range_parser, true>(invalid_input(), iterations);
+}
+
+void tracking_objects(std::size_t iterations) {
+  run<parsers::interpreters::object_parser, true>(valid_input(), iterations);
+}
+
+void disabled_objects(std::size_t iterations) {
+  run<parsers::interpreters::object_parser, false>(valid_input(), iterations);
+}
+
+const parsers_bench::registration registrations[] = {
+    {"failures/valid/plain", &plain_valid, input_size},
+    {"failures/valid/disabled", &disabled_valid, input_size},
+    {"failures/valid/tracking", &tracking_valid, input_size},
+    {"failures/invalid/disabled", &disabled_invalid, input_size},
+    {"failures/invalid/tracking", &tracking_invalid, input_size},
+    {"failures/objects/disabled", &disabled_objects, input_size},
+    {"failures/objects/tracking", &tracking_objects, input_size},
+};
+}  // namespace
@@ -0,0 +1,79 @@
+#ifndef GUARD_PARSERS_BENCHMARKS_HARNESS_HPP
+#define GUARD_PARSERS_BENCHMARKS_HARNESS_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace parsers_bench {
+
+template <class T>
+inline void do_not_optimize(const T& value) noexcept {
+#if defined(_MSC_VER)
+  const volatile auto* sink = &value;
+  static_cast<void>(sink);
+#else
+  asm volatile("" : : "r,m"(value) : "memory");
+#endif
+}
+
+using benchmark_function = void (*)(std::size_t iterations);
+
+struct benchmark {
+  std::string name;
+  benchmark_function run;
+  std::size_t bytes;  // input processed by each iteration, 0 if irrelevant
+};
+
+inline std::vector<benchmark>& registry() noexcept {
+  static std::vector<benchmark> benchmarks;
+  return benchmarks;
+}
+
+struct registration {
+  registration(std::string name,
+               benchmark_function run,
+               std::size_t bytes = 0) {
+    registry().push_back(benchmark{std::move(name), run, bytes});
+  }
+};
+
+struct measurement {
+  std::string name;
+  std::size_t iterations;
+  double nanoseconds;
+  std::size_t bytes;
+
+  [[nodiscard]] double nanoseconds_per_iteration() const noexcept {
+    return nanoseconds / static_cast<double>(iterations);
+  }
+
+  [[nodiscard]] double bytes_per_second() const noexcept {
+    return static_cast<double>(bytes) * 1e9 / nanoseconds_per_iteration();
+  }
+};
+
+inline measurement measure(const benchmark& bench,
+                           std::chrono::nanoseconds min_time) {
+  using clock = std::chrono::steady_clock;
+  std::size_t iterations = 1;
+  while (true) {
+    const auto start = clock::now();
+    bench.run(iterations);
+    const auto elapsed = clock::now() - start;
+    if (elapsed >= min_time || iterations >= (std::size_t{1} << 40U)) {
+      return measurement{
+          bench.name,
+          iterations,
+          std::chrono::duration<double, std::nano>(elapsed).count(),
+          bench.bytes};
+    }
+    iterations *= 2;
+  }
+}
+
+}  // namespace parsers_bench
+
+#endif  // GUARD_PARSERS_BENCHMARKS_HARNESS_HPP
@@ -0,0 +1,87 @@
+#include "./harness.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+void write_json(std::ostream& out,
+                const std::vector<parsers_bench::measurement>& results) {
+  out.precision(12);
+  out << "[";
+  const char* separator = "\n";
+  for (const auto& m : results) {
+    out << separator << "  {\"name\": \"" << m.name
+        << "\", \"iterations\": " << m.iterations
+        << ", \"ns_per_iteration\": " << m.nanoseconds_per_iteration()
+        << ", \"bytes\": " << m.bytes;
+    if (m.bytes != 0) {
+      out << ", \"bytes_per_second\": " << m.bytes_per_second();
+    }
+    out << "}";
+    separator = ",\n";
+  }
+  out << "\n]\n";
+}
+}  // namespace
+
+// Usage: parsers_bench [--json=FILE] [--max-bytes=N] [FILTER]
+// Benchmarks whose name does not contain FILTER, or that process more than N
+// bytes per iteration (1 MiB by default), are skipped.
+int main(int argc, const char** argv) {
+  using namespace std::chrono_literals;
+  std::string filter;
+  std::string json_path;
+  std::size_t max_bytes = std::size_t{1} << 20U;
+  for (int i = 1; i < argc; ++i) {
+    const std::string_view arg = argv[i];
+    if (arg.substr(0, 7) == "--json=") {
+      json_path = arg.substr(7);
+    }
+    else if (arg.substr(0, 12) == "--max-bytes=") {
+      max_bytes = std::strtoull(argv[i] + 12, nullptr, 10);
+    }
+    else {
+      filter = arg;
+    }
+  }
+
+  std::vector<parsers_bench::measurement> results;
+  for (const auto& bench : parsers_bench::registry()) {
+    if (bench.name.find(filter) == std::string::npos ||
+        bench.bytes > max_bytes) {
+      continue;
+    }
+    const auto m = parsers_bench::measure(bench, 200ms);
+    if (m.bytes != 0) {
+      std::printf("%-48s %12zu iterations %14.2f ns/iteration %10.2f MB/s\n",
+                  m.name.c_str(),
+                  m.iterations,
+                  m.nanoseconds_per_iteration(),
+                  m.bytes_per_second() / 1e6);
+    }
+    else {
+      std::printf("%-48s %12zu iterations %14.2f ns/iteration\n",
+                  m.name.c_str(),
+                  m.iterations,
+                  m.nanoseconds_per_iteration());
+    }
+    results.push_back(m);
+  }
+
+  if (!json_path.empty()) {
+    std::ofstream out{json_path};
+    write_json(out, results);
+    if (!out) {
+      std::fprintf(stderr, "could not write %s\n", json_path.c_str());
+      return 1;
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,125 @@
+#include "./harness.hpp"
+
+#include <parsers/parsers.hpp>
+
+#include <string>
+
+namespace {
+using namespace parsers::description;
+using namespace parsers::dsl;
+
+struct expression;
+using number = many1<ascii::digit_t>;
+using factor =
+    alternative<number, sequence<character<'('>, expression, character<')'>>>;
+using term = sequence<factor, many<sequence<character<'*'>, factor>>>;
+struct expression
+    : recursive<sequence<term, many<sequence<character<'+'>, term>>>> {};
+
+struct list;
+using element = alternative<number, list>;
+struct list : recursive<sequence<character<'['>,
+                                 many<sequence<element, many<character<','>>>>,
+                                 character<']'>>> {};
+
+struct {
+  constexpr int operator()(char c) const noexcept { return c - '0'; }
+} constexpr to_int;
+constexpr auto digits = many{map{ascii::digit, to_int}};
+
+const std::string& arithmetic_input() {
+  static const std::string text = [] {
+    std::string result = "1";
+    for (int i = 0; i < 512; ++i) {
+      result += "+(" + std::to_string(i) + "*(2+" + std::to_string(i % 13) +
+                "))*3";
+    }
+    return result;
+  }();
+  return text;
+}
+
+const std::string& list_input() {
+  static const std::string text = [] {
+    std::string result = "[";
+    for (int i = 0; i < 512; ++i) {
+      result += "[" + std::to_string(i) + ",[[" + std::to_string(i % 7) +
+                "],[]],3],";
+    }
+    return result + "]";
+  }();
+  return text;
+}
+
+const std::string& digits_input() {
+  static const std::string text(4096, '7');
+  return text;
+}
+
+void range_arithmetic(std::size_t iterations) {
+  for (std::size_t i = 0; i < iterations; ++i) {
+    parsers_bench::do_not_optimize(
+        parsers::parse_range(expression{}, arithmetic_input()));
+  }
+}
+
+void range_lists(std::size_t iterations) {
+  for (std::size_t i = 0; i < iterations; ++i) {
+    parsers_bench::do_not_optimize(
+        parsers::parse_range(list{}, list_input()));
+  }
+}
+
+void offsets_arithmetic(std::size_t iterations) {
+  for (std::size_t i = 0; i < iterations; ++i) {
+    parsers_bench::do_not_optimize(
+        parsers::parse_offsets(expression{}, arithmetic_input()));
+  }
+}
+
+void offsets_lists(std::size_t iterations) {
+  for (std::size_t i = 0; i < iterations; ++i) {
+    parsers_bench::do_not_optimize(
+        parsers::parse_offsets(list{}, list_input()));
+  }
+}
+
+void object_digits(std::size_t iterations) {
+  for (std::size_t i = 0; i < iterations; ++i) {
+    parsers_bench::do_not_optimize(parsers::parse(digits, digits_input()));
+  }
+}
+
+void two_phase_digits(std::size_t iterations) {
+  parsers::repetition_sizes sizes;
+  for (std::size_t i = 0; i < iterations; ++i) {
+    parsers_bench::do_not_optimize(
+        parsers::parse_two_phase(digits, digits_input(), sizes));
+  }
+}
+
+void object_lists(std::size_t iterations) {
+  for (std::size_t i = 0; i < iterations; ++i) {
+    parsers_bench::do_not_optimize(parsers::parse(list{}, list_input()));
+  }
+}
+
+void two_phase_lists(std::size_t iterations) {
+  parsers::repetition_sizes sizes;
+  for (std::size_t i = 0; i < iterations; ++i) {
+    parsers_bench::do_not_optimize(
+        parsers::parse_two_phase(list{}, list_input(), sizes));
+  }
+}
+
+const parsers_bench::registration registrations[] = {
+    {"result/range/arithmetic", &range_arithmetic},
+    {"result/range/lists", &range_lists},
+    {"result/offsets/arithmetic", &offsets_arithmetic},
+    {"result/offsets/lists", &offsets_lists},
+    {"result/object/digits", &object_digits},
+    {"result/object/lists", &object_lists},
+    {"result/two_phase/digits", &two_phase_digits},
+    {"result/two_phase/lists", &two_phase_lists},
+};
+}  // namespace
@@ -0,0 +1,58 @@
+#include "./harness.hpp"
+
+#include <parsers/parsers.hpp>
+
+#include <string>
+
+namespace {
+using namespace parsers::description;
+using namespace parsers::dsl;
+
+struct expression;
+using number = many1<ascii::digit_t>;
+using factor =
+    alternative<number, sequence<character<'('>, expression, character<')'>>>;
+using term = sequence<factor, many<sequence<character<'*'>, factor>>>;
+struct expression
+    : recursive<sequence<term, many<sequence<character<'+'>, term>>>> {};
+
+using iterator = std::string::const_iterator;
+extern const parsers::rule<iterator> expression_rule;
+const parsers::rule<iterator> factor_rule{
+    number{} | sequence{'('_c, ref(expression_rule), ')'_c}};
+const parsers::rule<iterator> term_rule{
+    sequence{ref(factor_rule), many{sequence{'*'_c, ref(factor_rule)}}}};
+const parsers::rule<iterator> expression_rule{
+    sequence{ref(term_rule), many{sequence{'+'_c, ref(term_rule)}}}};
+
+const std::string& input() {
+  static const std::string text = [] {
+    std::string result = "1";
+    for (int i = 0; i < 512; ++i) {
+      result += "+(" + std::to_string(i) + "*(2+" + std::to_string(i % 13) +
+                "))*3";
+    }
+    return result;
+  }();
+  return text;
+}
+
+void description(std::size_t iterations) {
+  for (std::size_t i = 0; i < iterations; ++i) {
+    parsers_bench::do_not_optimize(
+        parsers::parse_range(expression{}, input()));
+  }
+}
+
+void rules(std::size_t iterations) {
+  for (std::size_t i = 0; i < iterations; ++i) {
+    parsers_bench::do_not_optimize(
+        parsers::parse_range(ref(expression_rule), input()));
+  }
+}
+
+const parsers_bench::registration registrations[] = {
+    {"rule/description/arithmetic", &description},
+    {"rule/rules/arithmetic", &rules},
+};
+}  // namespace
@@ -0,0 +1,71 @@
+#include "./harness.hpp"
+
+#include <parsers/parsers.hpp>
+
+#include <string>
+#include <vector>
+
+namespace {
+using namespace parsers::description;
+using namespace parsers::dsl;
+
+constexpr std::size_t input_size = std::size_t{1} << 16U;
+
+using digit = ascii::digit_t;
+
+const std::string& list_input() {
+  static const std::string text = [] {
+    std::string result = "0";
+    for (std::size_t i = 1; result.size() < input_size; ++i) {
+      result += ',';
+      result += static_cast<char>('0' + i % 10);
+    }
+    return result;
+  }();
+  return text;
+}
+
+// What a list takes without `sep_by`: the first element and the others are
+// merged into a single vector afterwards.
+struct merge {
+  template <class T>
+  std::vector<char> operator()(T&& t) const {
+    auto& [first, rest] = t;
+    std::vector<char> result;
+    result.reserve(rest.size() + 1);
+    result.push_back(first);
+    result.insert(result.end(), rest.begin(), rest.end());
+    return result;
+  }
+};
+
+void merged_list(std::size_t iterations) {
+  const auto list =
+      (digit{} & many{~character<','>{} & digit{}}) / merge{};
+  for (std::size_t i = 0; i < iterations; ++i) {
+    parsers_bench::do_not_optimize(
+        parsers::parse(list, list_input())->size());
+  }
+}
+
+void sep_by_list(std::size_t iterations) {
+  for (std::size_t i = 0; i < iterations; ++i) {
+    parsers_bench::do_not_optimize(
+        parsers::parse(sep_by<digit, character<','>>{}, list_input())
+            ->size());
+  }
+}
+
+void sep_by_match(std::size_t iterations) {
+  for (std::size_t i = 0; i < iterations; ++i) {
+    parsers_bench::do_not_optimize(parsers::match_length(
+        sep_by<digit, character<','>>{}, list_input()));
+  }
+}
+
+const parsers_bench::registration registrations[] = {
+    {"separated/merged", &merged_list, input_size},
+    {"separated/sep_by", &sep_by_list, input_size},
+    {"separated/match", &sep_by_match, input_size},
+};
+}  // namespace
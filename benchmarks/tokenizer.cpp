@@ -0,0 +1,119 @@
+#include "./harness.hpp"
+
+#include <parsers/parsers.hpp>
+#include <parsers/tokenizer.hpp>
+
+#include <cstdint>
+#include <string>
+
+namespace {
+using namespace parsers::description;
+using namespace parsers::dsl;
+
+const std::string& input() {
+  static const std::string text = [] {
+    std::string result;
+    for (int i = 0; i < 256; ++i) {
+      result += "let value" + std::to_string(i) + " = " + std::to_string(i) +
+                " + x ;\n letter = letter + 1 ;\n print value ;\n";
+    }
+    return result;
+  }();
+  return text;
+}
+
+using spaces = many<ascii::space_t>;
+template <class T>
+using lexeme = sequence<spaces, T>;
+using identifier = lexeme<many1<ascii::alnum_t>>;
+using number = lexeme<many1<ascii::digit_t>>;
+using operand = alternative<number, identifier>;
+using expression =
+    sequence<operand, many<sequence<lexeme<character<'+'>>, operand>>>;
+using end_of_statement = lexeme<character<';'>>;
+template <char... Cs>
+using keyword = lexeme<sequence<character<Cs>...>>;
+using statements = many<alternative<
+    sequence<keyword<'l', 'e', 't'>,
+             identifier,
+             lexeme<character<'='>>,
+             expression,
+             end_of_statement>,
+    sequence<keyword<'p', 'r', 'i', 'n', 't'>, expression, end_of_statement>,
+    sequence<identifier,
+             lexeme<character<'='>>,
+             expression,
+             end_of_statement>>>;
+
+void characters(std::size_t iterations) {
+  for (std::size_t i = 0; i < iterations; ++i) {
+    parsers_bench::do_not_optimize(parsers::parse_range(statements{}, input()));
+  }
+}
+
+enum class kind : std::uint8_t {
+  let,
+  print,
+  identifier,
+  number,
+  equal,
+  plus,
+  semicolon
+};
+
+template <kind K>
+using is = character<K>;
+using token_operand = alternative<is<kind::number>, is<kind::identifier>>;
+using token_expression =
+    sequence<token_operand, many<sequence<is<kind::plus>, token_operand>>>;
+using token_statements = many<alternative<
+    sequence<is<kind::let>,
+             is<kind::identifier>,
+             is<kind::equal>,
+             token_expression,
+             is<kind::semicolon>>,
+    sequence<is<kind::print>, token_expression, is<kind::semicolon>>,
+    sequence<is<kind::identifier>,
+             is<kind::equal>,
+             token_expression,
+             is<kind::semicolon>>>>;
+
+const auto lexer = parsers::tokenizer{
+    many{ascii::space},
+    parsers::lexeme{kind::let, "let"_s},
+    parsers::lexeme{kind::print, "print"_s},
+    parsers::lexeme{kind::identifier, many1{ascii::alnum}},
+    parsers::lexeme{kind::number, many1{ascii::digit}},
+    parsers::lexeme{kind::equal, '='_c},
+    parsers::lexeme{kind::plus, '+'_c},
+    parsers::lexeme{kind::semicolon, ';'_c}};
+
+void tokens(std::size_t iterations) {
+  for (std::size_t i = 0; i < iterations; ++i) {
+    const auto tokens = lexer(input());
+    parsers_bench::do_not_optimize(
+        parsers::parse_range(token_statements{}, tokens.value()));
+  }
+}
+
+void tokenize_only(std::size_t iterations) {
+  for (std::size_t i = 0; i < iterations; ++i) {
+    parsers_bench::do_not_optimize(lexer(input()));
+  }
+}
+
+void tokens_parse_only(std::size_t iterations) {
+  const auto tokens = lexer(input());
+  for (std::size_t i = 0; i < iterations; ++i) {
+    parsers_bench::do_not_optimize(
+        parsers::parse_range(token_statements{}, tokens.value()));
+  }
+}
+
+const parsers_bench::registration registrations[] = {
+    {"tokenizer/characters/statements", &characters},
+    {"tokenizer/tokens/statements", &tokens},
+    {"tokenizer/tokenize_only/statements", &tokenize_only},
+    {"tokenizer/tokens_parse_only/statements", &tokens_parse_only},
+};
+}  // namespace
@@ -0,0 +1,65 @@
+#include "./harness.hpp"
+
+#include <parsers/parsers.hpp>
+#include <parsers/runtime/grammar.hpp>
+#include <parsers/vm.hpp>
+
+#include <string>
+
+namespace {
+using namespace parsers::description;
+
+using identifier =
+    sequence<alternative<ascii::alpha_t, character<'_'>>,
+             many<alternative<ascii::alnum_t, character<'_'>>>>;
+using number = sequence<many1<ascii::digit_t>,
+                        alternative<sequence<character<'.'>,
+                                             many1<ascii::digit_t>>,
+                                    succeed_t>>;
+using token = alternative<identifier, number, character<'+'>, character<'*'>>;
+using tokens = many<sequence<many<ascii::space_t>, token>>;
+
+const std::string& input() {
+  static const std::string text = [] {
+    std::string result;
+    for (int i = 0; i < 256; ++i) {
+      result += "value_" + std::to_string(i) + " + 3.25 * x" +
+                std::to_string(i % 7) + " ";
+    }
+    return result;
+  }();
+  return text;
+}
+
+void range_parser(std::size_t iterations) {
+  for (std::size_t i = 0; i < iterations; ++i) {
+    parsers_bench::do_not_optimize(parsers::parse_range(tokens{}, input()));
+  }
+}
+
+void bytecode(std::size_t iterations) {
+  const auto program = parsers::vm::compile(tokens{});
+  for (std::size_t i = 0; i < iterations; ++i) {
+    parsers_bench::do_not_optimize(program(input().begin(), input().end()));
+  }
+}
+
+void runtime_grammar(std::size_t iterations) {
+  const auto grammar = parsers::runtime::grammar::load(R"(
+    tokens <- ([ \t\n\r]* token)*
+    token <- identifier / number / '+' / '*'
+    identifier <- [a-zA-Z_] [a-zA-Z0-9_]*
+    number <- [0-9]+ ('.' [0-9]+)?
+  )");
+  for (std::size_t i = 0; i < iterations; ++i) {
+    parsers_bench::do_not_optimize(
+        grammar.value()(input().begin(), input().end()));
+  }
+}
+
+const parsers_bench::registration registrations[] = {
+    {"vm/range_parser/tokens", &range_parser},
+    {"vm/bytecode/tokens", &bytecode},
+    {"vm/runtime_grammar/tokens", &runtime_grammar},
+};
+}  // namespace
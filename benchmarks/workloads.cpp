@@ -0,0 +1,615 @@
+#include "./harness.hpp"
+
+#include "../examples/cli_options/description.hpp"
+#include "../examples/math/description.hpp"
+
+#include <parsers/parsers.hpp>
+
+#include <charconv>
+#include <cstdint>
+#include <iterator>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Canonical grammars run over generated inputs of increasing size. Every
+// input is a sequence of newline-terminated records, parsed one at a time by
+// the library and by the baselines it is compared with.
+namespace {
+using namespace parsers::description;
+
+template <class T>
+using d = discard<T>;
+template <char... Cs>
+using keyword = sequence<character<Cs>...>;
+using ws = d<many<ascii::blank_t>>;
+
+// Deterministic across platforms, unlike the standard distributions.
+struct lcg {
+  std::uint32_t state;
+
+  std::uint32_t operator()(std::uint32_t bound) noexcept {
+    state = state * 1664525U + 1013904223U;
+    return (state >> 8U) % bound;
+  }
+};
+
+struct corpus {
+  std::string text;
+  std::vector<std::string_view> records;
+};
+
+// Keeps only the last corpus generated, so that the largest inputs are not
+// all held in memory at once.
+template <class Workload>
+const corpus& load(std::size_t bytes) {
+  static const void* workload = nullptr;
+  static std::size_t size = 0;
+  static corpus data;
+  if (workload != &Workload::name || size != bytes) {
+    data = corpus{};
+    lcg rng{static_cast<std::uint32_t>(bytes)};
+    while (data.text.size() < bytes) {
+      Workload::generate(data.text, rng);
+      data.text += '\n';
+    }
+    std::size_t begin = 0;
+    for (std::size_t i = 0; i < data.text.size(); ++i) {
+      if (data.text[i] == '\n') {
+        data.records.emplace_back(data.text.data() + begin, i - begin);
+        begin = i + 1;
+      }
+    }
+    workload = &Workload::name;
+    size = bytes;
+  }
+  return data;
+}
+
+constexpr bool is_digit(char c) noexcept { return c >= '0' && c <= '9'; }
+
+std::size_t skip_digits(std::string_view s, std::size_t i) noexcept {
+  while (i < s.size() && is_digit(s[i])) {
+    ++i;
+  }
+  return i;
+}
+
+std::size_t skip_blanks(std::string_view s, std::size_t i) noexcept {
+  while (i < s.size() && (s[i] == ' ' || s[i] == '\t')) {
+    ++i;
+  }
+  return i;
+}
+
+//////////////////////////////////////////////////////////////////////////////
+// math: the expressions of examples/math, parsed into an AST.
+struct math_workload {
+  constexpr static inline const char* name = "math";
+  constexpr static inline auto description = math::math_expression;
+
+  static void generate(std::string& out, lcg& rng) {
+    constexpr const char* operators[] = {" + ", " - ", " * ", " / ", " ^ "};
+    const auto operand = [&] {
+      if (rng(4) == 0) {
+        out += '(';
+        out += std::to_string(rng(1000));
+        out += operators[rng(5)];
+        out += std::to_string(rng(100));
+        out += ')';
+      }
+      else {
+        out += std::to_string(rng(100000));
+      }
+    };
+    operand();
+    for (auto n = rng(6); n > 0; --n) {
+      out += operators[rng(5)];
+      operand();
+    }
+  }
+
+  static bool hand_written(std::string_view s) noexcept {
+    int depth = 0;
+    bool operand = true;
+    for (std::size_t i = skip_blanks(s, 0); i < s.size();
+         i = skip_blanks(s, i)) {
+      const char c = s[i];
+      if (operand && c == '(') {
+        ++depth;
+        ++i;
+      }
+      else if (operand) {
+        const auto first = c == '-' ? i + 1 : i;
+        i = skip_digits(s, first);
+        if (i == first) {
+          return false;
+        }
+        operand = false;
+      }
+      else if (c == ')' && depth > 0) {
+        --depth;
+        ++i;
+      }
+      else if (c == '+' || c == '-' || c == '*' || c == '/' || c == '^') {
+        operand = true;
+        ++i;
+      }
+      else {
+        return false;
+      }
+    }
+    return depth == 0 && !operand;
+  }
+};
+
+//////////////////////////////////////////////////////////////////////////////
+// cli_options: the option lists of examples/cli_options.
+struct cli_options_workload {
+  constexpr static inline const char* name = "cli_options";
+  constexpr static inline auto description = cli_options::option_list{};
+
+  static void generate(std::string& out, lcg& rng) {
+    constexpr const char* options[] = {" -v",
+                                       " -j 8",
+                                       " --output=build/out.txt",
+                                       " --name \"quoted value\"",
+                                       " --dry-run",
+                                       " --log-level debug",
+                                       " -I include"};
+    for (auto n = rng(6) + 1; n > 0; --n) {
+      out += options[rng(7)];
+    }
+  }
+
+  static bool hand_written(std::string_view s) noexcept {
+    std::size_t i = 0;
+    while (i < s.size()) {
+      const auto start = i;
+      i = skip_blanks(s, i);
+      if (i == s.size()) {
+        return true;
+      }
+      if (i == start || s[i] != '-') {
+        return false;
+      }
+      while (i < s.size() && s[i] != ' ' && s[i] != '\t') {
+        ++i;
+      }
+      const auto value = skip_blanks(s, i);
+      if (value < s.size() && s[value] == '"') {
+        const auto closing = s.find('"', value + 1);
+        if (closing == std::string_view::npos) {
+          return false;
+        }
+        i = closing + 1;
+      }
+      else if (value < s.size() && s[value] != '-') {
+        i = value;
+        while (i < s.size() && s[i] != ' ' && s[i] != '\t') {
+          ++i;
+        }
+      }
+    }
+    return true;
+  }
+};
+
+//////////////////////////////////////////////////////////////////////////////
+// csv: rows of an id, a name, a quantity and a price in cents.
+struct csv_field : satisfy_character<csv_field> {
+  template <class T>
+  constexpr bool operator()(T c) const noexcept {
+    return c != ',' && c != '\n';
+  }
+};
+using comma = d<character<','>>;
+using csv_row = sequence<ascii::integer,
+                         comma,
+                         as_range<many1<csv_field>>,
+                         comma,
+                         ascii::integer,
+                         comma,
+                         ascii::integer>;
+
+struct csv_workload {
+  constexpr static inline const char* name = "csv";
+  constexpr static inline auto description = csv_row{};
+
+  static void generate(std::string& out, lcg& rng) {
+    out += std::to_string(rng(1000000));
+    out += ",item ";
+    out += std::to_string(rng(5000));
+    out += ',';
+    out += std::to_string(rng(100));
+    out += ',';
+    out += std::to_string(rng(100000));
+  }
+
+  static bool hand_written(std::string_view s) noexcept {
+    std::size_t i = skip_digits(s, 0);
+    if (i == 0 || i == s.size() || s[i] != ',') {
+      return false;
+    }
+    const auto name = ++i;
+    while (i < s.size() && s[i] != ',') {
+      ++i;
+    }
+    for (int field = 0; field < 2; ++field) {
+      if (i == name || i == s.size() || s[i] != ',') {
+        return false;
+      }
+      const auto first = ++i;
+      i = skip_digits(s, i);
+      if (i == first) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  struct row {
+    int id;
+    std::string_view name;
+    int quantity;
+    int price;
+  };
+
+  // Builds the same values as `parse`, numbers being converted by
+  // std::from_chars.
+  static bool from_chars(std::string_view s, row& out) noexcept {
+    const auto* const end = s.data() + s.size();
+    auto r = std::from_chars(s.data(), end, out.id);
+    if (r.ec != std::errc{} || r.ptr == end || *r.ptr != ',') {
+      return false;
+    }
+    const auto* const name = r.ptr + 1;
+    const auto* comma = name;
+    while (comma != end && *comma != ',') {
+      ++comma;
+    }
+    if (comma == name || comma == end) {
+      return false;
+    }
+    out.name = std::string_view{name, static_cast<std::size_t>(comma - name)};
+    r = std::from_chars(comma + 1, end, out.quantity);
+    if (r.ec != std::errc{} || r.ptr == end || *r.ptr != ',') {
+      return false;
+    }
+    return std::from_chars(r.ptr + 1, end, out.price).ec == std::errc{};
+  }
+
+  static const std::regex& regex() {
+    static const std::regex re{R"((\d+),([^,]+),(\d+),(\d+))",
+                               std::regex::optimize};
+    return re;
+  }
+};
+
+//////////////////////////////////////////////////////////////////////////////
+// json: flat objects whose values are scalars or arrays of scalars.
+struct json_character : satisfy_character<json_character> {
+  template <class T>
+  constexpr bool operator()(T c) const noexcept {
+    return c != '"' && c != '\\';
+  }
+};
+using json_string = sequence<
+    d<character<'"'>>,
+    as_range<many<either<both<character<'\\'>, ascii::print_t>,
+                         json_character>>>,
+    d<character<'"'>>>;
+using json_literal =
+    as_range<choose<sequence<optional<character<'-'>>, many1<ascii::digit_t>>,
+                    keyword<'t', 'r', 'u', 'e'>,
+                    keyword<'f', 'a', 'l', 's', 'e'>,
+                    keyword<'n', 'u', 'l', 'l'>>>;
+using json_scalar = choose<json_string, json_literal>;
+template <class T, char Open, char Close>
+using json_list = sequence<d<character<Open>>,
+                           ws,
+                           T,
+                           many<sequence<ws, comma, ws, T>>,
+                           ws,
+                           d<character<Close>>>;
+using json_member =
+    sequence<json_string,
+             ws,
+             d<character<':'>>,
+             ws,
+             alternative<json_scalar, json_list<json_scalar, '[', ']'>>>;
+using json_object = json_list<json_member, '{', '}'>;
+
+struct json_workload {
+  constexpr static inline const char* name = "json";
+  constexpr static inline auto description = json_object{};
+
+  static void generate(std::string& out, lcg& rng) {
+    out += "{\"id\": ";
+    out += std::to_string(rng(1000000));
+    out += ", \"name\": \"user \\\"";
+    out += std::to_string(rng(5000));
+    out += "\\\"\", \"active\": ";
+    out += rng(2) == 0 ? "true" : "false";
+    out += ", \"scores\": [";
+    for (auto n = rng(8) + 1; n > 0; --n) {
+      out += std::to_string(rng(100));
+      out += n > 1 ? ", " : "";
+    }
+    out += "], \"tags\": [\"alpha\", \"beta\"], \"parent\": null}";
+  }
+
+  static bool hand_written(std::string_view s) noexcept {
+    std::size_t i = 0;
+    const auto expect = [&](char c) {
+      i = skip_blanks(s, i);
+      if (i < s.size() && s[i] == c) {
+        ++i;
+        return true;
+      }
+      return false;
+    };
+    const auto string = [&] {
+      if (!expect('"')) {
+        return false;
+      }
+      while (i < s.size() && s[i] != '"') {
+        i += s[i] == '\\' ? 2 : 1;
+      }
+      return expect('"');
+    };
+    const auto scalar = [&] {
+      i = skip_blanks(s, i);
+      if (i < s.size() && s[i] == '"') {
+        return string();
+      }
+      for (std::string_view word : {"true", "false", "null"}) {
+        if (s.substr(i, word.size()) == word) {
+          i += word.size();
+          return true;
+        }
+      }
+      const auto first = i < s.size() && s[i] == '-' ? i + 1 : i;
+      i = skip_digits(s, first);
+      return i != first;
+    };
+    if (!expect('{')) {
+      return false;
+    }
+    do {
+      if (!string() || !expect(':')) {
+        return false;
+      }
+      if (expect('[')) {
+        do {
+          if (!scalar()) {
+            return false;
+          }
+        } while (expect(','));
+        if (!expect(']')) {
+          return false;
+        }
+      }
+      else if (!scalar()) {
+        return false;
+      }
+    } while (expect(','));
+    return expect('}');
+  }
+};
+
+//////////////////////////////////////////////////////////////////////////////
+// log: timestamped lines with a level, a source and a free-form message.
+struct timestamp_character : satisfy_character<timestamp_character> {
+  template <class T>
+  constexpr bool operator()(T c) const noexcept {
+    return is_digit(c) || c == '-' || c == ':' || c == '.' || c == 'T';
+  }
+};
+struct source_character : satisfy_character<source_character> {
+  template <class T>
+  constexpr bool operator()(T c) const noexcept {
+    return c != ']';
+  }
+};
+using space = d<character<' '>>;
+using log_level = as_range<choose<keyword<'D', 'E', 'B', 'U', 'G'>,
+                                  keyword<'I', 'N', 'F', 'O'>,
+                                  keyword<'W', 'A', 'R', 'N'>,
+                                  keyword<'E', 'R', 'R', 'O', 'R'>>>;
+using log_line =
+    sequence<as_range<many1<timestamp_character>>,
+             space,
+             log_level,
+             space,
+             d<character<'['>>,
+             as_range<many1<source_character>>,
+             d<character<']'>>,
+             space,
+             as_range<many<ascii::print_t>>>;
+
+struct log_workload {
+  constexpr static inline const char* name = "log";
+  constexpr static inline auto description = log_line{};
+
+  static void generate(std::string& out, lcg& rng) {
+    constexpr const char* levels[] = {"DEBUG", "INFO", "WARN", "ERROR"};
+    out += "2026-10-";
+    out += std::to_string(10 + rng(20));
+    out += "T12:";
+    out += std::to_string(10 + rng(50));
+    out += ':';
+    out += std::to_string(10 + rng(50));
+    out += '.';
+    out += std::to_string(100 + rng(900));
+    out += ' ';
+    out += levels[rng(4)];
+    out += " [worker-";
+    out += std::to_string(rng(16));
+    out += "] request ";
+    out += std::to_string(rng(100000));
+    out += " completed in ";
+    out += std::to_string(rng(1000));
+    out += " ms";
+  }
+
+  static bool hand_written(std::string_view s) noexcept {
+    std::size_t i = 0;
+    while (i < s.size() && timestamp_character{}(s[i])) {
+      ++i;
+    }
+    if (i == 0 || i == s.size() || s[i] != ' ') {
+      return false;
+    }
+    const auto level = s.substr(i + 1, s.find(' ', i + 1) - i - 1);
+    if (level != "DEBUG" && level != "INFO" && level != "WARN" &&
+        level != "ERROR") {
+      return false;
+    }
+    i += level.size() + 2;
+    if (i >= s.size() || s[i] != '[') {
+      return false;
+    }
+    const auto closing = s.find(']', i);
+    return closing != std::string_view::npos && closing > i + 1 &&
+           closing + 1 < s.size() && s[closing + 1] == ' ';
+  }
+
+  static const std::regex& regex() {
+    static const std::regex re{
+        R"(([-0-9:.T]+) (DEBUG|INFO|WARN|ERROR) \[([^\]]+)\] (.*))",
+        std::regex::optimize};
+    return re;
+  }
+};
+
+//////////////////////////////////////////////////////////////////////////////
+// What is done with each record.
+struct match_api {
+  constexpr static inline const char* name = "match";
+  template <class W>
+  static bool run(std::string_view record) noexcept {
+    return parsers::match(W::description, record);
+  }
+};
+
+struct range_api {
+  constexpr static inline const char* name = "parse_range";
+  template <class W>
+  static auto run(std::string_view record) noexcept {
+    return parsers::parse_range(W::description, record);
+  }
+};
+
+struct parse_api {
+  constexpr static inline const char* name = "parse";
+  template <class W>
+  static auto run(std::string_view record) {
+    return parsers::parse(W::description, record);
+  }
+};
+
+struct two_phase_api {
+  constexpr static inline const char* name = "parse_two_phase";
+  template <class W>
+  static auto run(std::string_view record) {
+    static parsers::repetition_sizes sizes;
+    return parsers::parse_two_phase(W::description, record, sizes);
+  }
+};
+
+struct hand_written_api {
+  constexpr static inline const char* name = "hand_written";
+  template <class W>
+  static bool run(std::string_view record) noexcept {
+    return W::hand_written(record);
+  }
+};
+
+struct from_chars_api {
+  constexpr static inline const char* name = "from_chars";
+  template <class W>
+  static auto run(std::string_view record) noexcept {
+    typename W::row row{};
+    return std::make_pair(W::from_chars(record, row), row);
+  }
+};
+
+struct regex_api {
+  constexpr static inline const char* name = "std_regex";
+  template <class W>
+  static auto run(std::string_view record) {
+    std::match_results<std::string_view::const_iterator> m;
+    std::regex_match(record.begin(), record.end(), m, W::regex());
+    return m.size();
+  }
+};
+
+template <class W, class Api, std::size_t Bytes>
+void run(std::size_t iterations) {
+  const auto& input = load<W>(Bytes);
+  for (std::size_t i = 0; i < iterations; ++i) {
+    for (const auto record : input.records) {
+      parsers_bench::do_not_optimize(Api::template run<W>(record));
+    }
+  }
+}
+
+constexpr std::pair<std::size_t, const char*> sizes[] = {
+    {std::size_t{1} << 10U, "1KiB"},
+    {std::size_t{1} << 15U, "32KiB"},
+    {std::size_t{1} << 20U, "1MiB"},
+    {std::size_t{1} << 25U, "32MiB"},
+    {std::size_t{1} << 30U, "1GiB"},
+};
+
+template <class W, class Api, std::size_t... Is>
+void register_sizes(std::index_sequence<Is...> /*unused*/) {
+  (parsers_bench::registration{std::string{"workload/"} + W::name + "/" +
+                                   Api::name + "/" + sizes[Is].second,
+                               &run<W, Api, sizes[Is].first>,
+                               sizes[Is].first},
+   ...);
+}
+
+template <class W, class... Apis>
+void register_workload() {
+  (register_sizes<W, Apis>(std::make_index_sequence<std::size(sizes)>{}), ...);
+}
+
+const bool registered = [] {
+  register_workload<math_workload,
+                    match_api,
+                    range_api,
+                    parse_api,
+                    hand_written_api>();
+  register_workload<cli_options_workload,
+                    match_api,
+                    range_api,
+                    parse_api,
+                    hand_written_api>();
+  register_workload<csv_workload,
+                    match_api,
+                    range_api,
+                    parse_api,
+                    two_phase_api,
+                    hand_written_api,
+                    from_chars_api,
+                    regex_api>();
+  register_workload<json_workload,
+                    match_api,
+                    range_api,
+                    parse_api,
+                    two_phase_api,
+                    hand_written_api>();
+  register_workload<log_workload,
+                    match_api,
+                    range_api,
+                    parse_api,
+                    hand_written_api,
+                    regex_api>();
+  return true;
+}();
+}  // namespace
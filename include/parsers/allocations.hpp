@@ -0,0 +1,77 @@
+#ifndef GUARD_PARSERS_ALLOCATIONS_HPP
+#define GUARD_PARSERS_ALLOCATIONS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace parsers {
+
+// Memory allocated by the object parser: the growth of the vectors built by
+// repetitions and the nodes of recursive descriptions. Allocations made by
+// the values themselves (a `std::string` built by `map` for example) are not
+// seen.
+struct allocation_count {
+  std::uint64_t allocations = 0;
+  std::uint64_t bytes = 0;
+};
+
+namespace detail {
+inline allocation_count*& current_allocation_count() noexcept {
+  thread_local allocation_count* current = nullptr;
+  return current;
+}
+
+inline void count_runtime_allocation(std::size_t bytes) noexcept {
+  if (auto* count = current_allocation_count()) {
+    ++count->allocations;
+    count->bytes += bytes;
+  }
+}
+
+// Callable from the constexpr parts of the object parser, which allocate
+// during constant evaluation since C++20.
+#if defined(__cpp_lib_is_constant_evaluated)
+constexpr void count_allocation(std::size_t bytes) noexcept {
+  if (!std::is_constant_evaluated()) {
+    count_runtime_allocation(bytes);
+  }
+}
+#else
+inline void count_allocation(std::size_t bytes) noexcept {
+  count_runtime_allocation(bytes);
+}
+#endif
+}  // namespace detail
+
+// Counts the allocations made by object parsers on the current thread for as
+// long as it lives. Scopes nest: when one ends, what it counted is added to
+// the enclosing one. Without a scope, counting costs a thread-local read per
+// allocation.
+class count_allocations {
+ public:
+  explicit count_allocations(allocation_count& target) noexcept
+      : _target{&target},
+        _enclosing{std::exchange(detail::current_allocation_count(),
+                                 &target)} {}
+
+  count_allocations(const count_allocations&) = delete;
+  count_allocations& operator=(const count_allocations&) = delete;
+
+  ~count_allocations() noexcept {
+    detail::current_allocation_count() = _enclosing;
+    if (_enclosing != nullptr) {
+      _enclosing->allocations += _target->allocations;
+      _enclosing->bytes += _target->bytes;
+    }
+  }
+
+ private:
+  allocation_count* _target;
+  allocation_count* _enclosing;
+};
+
+}  // namespace parsers
+
+#endif  // GUARD_PARSERS_ALLOCATIONS_HPP
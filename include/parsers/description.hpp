@@ -1,10 +1,16 @@
 #include "./description/alternative.hpp"
 #include "./description/ascii.hpp"
 #include "./description/basic_bind.hpp"
+#include "./description/bounded_range.hpp"
+#include "./description/commit.hpp"
 #include "./description/dynamic_range.hpp"
 #include "./description/guard.hpp"
+#include "./description/lazy_many.hpp"
 #include "./description/modifiers.hpp"
+#include "./description/recover.hpp"
 #include "./description/recursive.hpp"
+#include "./description/rule.hpp"
 #include "./description/satisfy.hpp"
+#include "./description/separated.hpp"
 #include "./description/sequence.hpp"
 #include "./description/static_string.hpp"
\ No newline at end of file
@@ -6,6 +6,12 @@
 
 namespace parsers::description::ascii {
 
+// `ascii::detail` also holds the case insensitive strings, whichever header
+// comes first.
+namespace detail {
+using ::parsers::description::detail::dynamic;
+}  // namespace detail
+
 template <class T>
 struct character_class : satisfy_character<character_class<T>>, T {
   using T::operator();
@@ -5,6 +5,9 @@
 
 #include "../result_traits.hpp"
 
+#include <string>
+#include <type_traits>
+
 namespace parsers::description {
 template <class D, class F, class I>
 struct basic_bind : private container<D> {
@@ -60,6 +63,24 @@ using is_bind = decltype(is_bind_f(std::declval<T>()));
 template <class T>
 constexpr static inline bool is_bind_v = is_bind<T>::value;
 
+constexpr std::false_type is_cached_bind_f(...) noexcept;
+template <class T>
+using is_cached_bind = decltype(is_cached_bind_f(std::declval<T>()));
+template <class T>
+constexpr static inline bool is_cached_bind_v = is_cached_bind<T>::value;
+
+// Whether a bound value can be kept by the cache of a `cached_bind`, which
+// outlives the input: the value must not refer to it (as a `range` or an
+// iterator does). Specialize to opt other types in.
+template <class T, class = void>
+struct is_cacheable_value
+    : std::bool_constant<std::is_arithmetic_v<T> || std::is_enum_v<T>> {};
+template <class C, class T, class A>
+struct is_cacheable_value<std::basic_string<C, T, A>> : std::true_type {};
+template <class T>
+constexpr static inline bool is_cacheable_value_v =
+    is_cacheable_value<T>::value;
+
 }  // namespace parsers::description
 
 #endif  // GUARD_PARSERS_DESCRIPTION_BIND_HPP
\ No newline at end of file
@@ -0,0 +1,88 @@
+#ifndef GUARD_PARSERS_DESCRIPTION_BOUNDED_RANGE_HPP
+#define GUARD_PARSERS_DESCRIPTION_BOUNDED_RANGE_HPP
+
+#include "../utility.hpp"
+#include "./containers.hpp"
+
+#include <cstddef>
+#include <type_traits>
+
+namespace parsers::description {
+namespace detail {
+template <std::size_t Min, std::size_t Max>
+struct static_bounds {
+  static_assert(Min <= Max, "the minimum can't be above the maximum");
+
+  constexpr static inline std::size_t minimum() noexcept { return Min; }
+  constexpr static inline std::size_t maximum() noexcept { return Max; }
+};
+struct dynamic_bounds {
+  constexpr dynamic_bounds(std::size_t n) noexcept : _min{n}, _max{n} {}
+  constexpr dynamic_bounds(std::size_t min, std::size_t max) noexcept
+      : _min{min}, _max{max} {}
+
+  [[nodiscard]] constexpr inline std::size_t minimum() const noexcept {
+    return _min;
+  }
+  [[nodiscard]] constexpr inline std::size_t maximum() const noexcept {
+    return _max;
+  }
+
+ private:
+  std::size_t _min;
+  std::size_t _max;
+};
+}  // namespace detail
+
+// Between `minimum()` and `maximum()` repetitions of `P`, stopping as soon
+// as the maximum is reached.
+template <class B, class P, class C = empty_container<P>>
+struct bounded_range : B, C {
+  using bounds_t = B;
+
+  constexpr bounded_range() noexcept = default;
+  template <class Q,
+            std::enable_if_t<!std::is_same_v<std::decay_t<Q>, bounded_range> &&
+                                 std::is_convertible_v<Q, P>,
+                             int> = 0>
+  constexpr explicit bounded_range(Q&& q) : B{}, C{std::forward<Q>(q)} {}
+  template <class Q>
+  constexpr bounded_range(std::size_t n, Q&& q)
+      : B{n}, C{std::forward<Q>(q)} {}
+  template <class Q>
+  constexpr bounded_range(std::size_t min, std::size_t max, Q&& q)
+      : B{min, max}, C{std::forward<Q>(q)} {}
+
+  friend constexpr std::true_type is_bounded_range_f(
+      const bounded_range&) noexcept;
+};
+template <class P, class P1 = detail::remove_cvref_t<P>>
+bounded_range(std::size_t, std::size_t, P&&)
+    -> bounded_range<detail::dynamic_bounds, P1, container<P1>>;
+
+template <std::size_t Min, std::size_t Max, class P, class C = empty_container<P>>
+using between = bounded_range<detail::static_bounds<Min, Max>, P, C>;
+
+// Exactly `N` repetitions of `P`, unrolled when `N` is small.
+template <std::size_t N, class P, class C = empty_container<P>>
+using repeat_n = bounded_range<detail::static_bounds<N, N>, P, C>;
+
+// Exactly `n` repetitions of `P`.
+template <class P, class C = empty_container<P>>
+struct repeat : bounded_range<detail::dynamic_bounds, P, C> {
+  using base = bounded_range<detail::dynamic_bounds, P, C>;
+
+  template <class Q>
+  constexpr repeat(std::size_t n, Q&& q) : base{n, std::forward<Q>(q)} {}
+};
+template <class P, class P1 = detail::remove_cvref_t<P>>
+repeat(std::size_t, P&&) -> repeat<P1, container<P1>>;
+
+constexpr std::false_type is_bounded_range_f(...) noexcept;
+template <class T>
+using is_bounded_range = decltype(is_bounded_range_f(std::declval<T>()));
+template <class T>
+constexpr static inline bool is_bounded_range_v = is_bounded_range<T>::value;
+}  // namespace parsers::description
+
+#endif  // GUARD_PARSERS_DESCRIPTION_BOUNDED_RANGE_HPP
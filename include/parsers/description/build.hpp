@@ -2,6 +2,7 @@
 #define GUARD_PARSERS_DESCRIPTION_BUILD_HPP
 
 #include <type_traits>
+#include "../interpreters/make_parser.hpp"
 #include "../interpreters/range_parser.hpp"
 #include "./modifiers.hpp"
 
@@ -0,0 +1,37 @@
+#ifndef GUARD_PARSERS_DESCRIPTION_CACHED_BIND_HPP
+#define GUARD_PARSERS_DESCRIPTION_CACHED_BIND_HPP
+
+#include "./bind.hpp"
+
+namespace parsers::description {
+
+// Same as `bind`, but the parser built for a value is kept and reused the
+// next time the same value is bound, instead of being rebuilt by calling the
+// function and interpreting its result again. Values of 1 byte integral types
+// index a table of 256 parsers, others are looked up by equality among the
+// first 16 distinct values bound, later values getting a parser built at each
+// call. Values that aren't `is_cacheable_value` are never cached, the parser
+// then behaves as a `bind`. The function must always return the same
+// description for equal values. The cache is updated by each call of the
+// parser, which therefore can't be shared between threads: give each thread
+// its own copy, copies starting with an empty cache.
+template <class D, class F>
+struct cached_bind : bind<D, F> {
+  using base = bind<D, F>;
+
+  constexpr cached_bind() noexcept = default;
+
+  template <class E, class G>
+  constexpr cached_bind(E&& desc, G&& func) noexcept
+      : base{std::forward<E>(desc), std::forward<G>(func)} {}
+
+  friend constexpr std::true_type is_cached_bind_f(
+      const cached_bind&) noexcept;
+};
+template <class D, class F>
+cached_bind(D&&, F&&)
+    -> cached_bind<detail::remove_cvref_t<D>, detail::remove_cvref_t<F>>;
+
+}  // namespace parsers::description
+
+#endif  // GUARD_PARSERS_DESCRIPTION_CACHED_BIND_HPP
@@ -0,0 +1,85 @@
+#ifndef GUARD_PARSERS_DESCRIPTION_COMMIT_HPP
+#define GUARD_PARSERS_DESCRIPTION_COMMIT_HPP
+
+#include "../utility.hpp"
+#include "./basic_bind.hpp"
+#include "./containers.hpp"
+#include "./rule.hpp"
+
+#include <type_traits>
+
+namespace parsers::description {
+
+// Cut: once the parser reached a `commit`, any failure of the branch it is
+// in, of its description or of what follows it, is fatal for the closest
+// enclosing choice (alternative, optional or repetition), which fails without
+// trying its other branches.
+template <class T>
+struct commit : container<T> {
+  using base = container<T>;
+
+  constexpr commit() noexcept = default;
+
+  template <
+      class U,
+      std::enable_if_t<!std::is_same_v<std::decay_t<U>, commit>, int> = 0>
+  constexpr explicit commit(U&& u) noexcept : base{std::forward<U>(u)} {}
+
+  friend constexpr std::true_type is_commit_f(const commit&) noexcept;
+};
+template <class T>
+commit(T&&) -> commit<detail::remove_cvref_t<T>>;
+
+constexpr std::false_type is_commit_f(...) noexcept;
+template <class T>
+using is_commit = decltype(is_commit_f(std::declval<T>()));
+template <class T>
+constexpr static inline bool is_commit_v = is_commit<T>::value;
+
+namespace detail {
+template <class... Ts>
+struct visited {};
+
+template <class T, class = void>
+struct has_parser_type : std::false_type {};
+template <class T>
+struct has_parser_type<T, std::void_t<typename T::parser_t>>
+    : std::true_type {};
+
+template <class T, class V = visited<>, class = void>
+struct may_commit : std::false_type {};
+
+template <class T, class V>
+struct may_commit_arguments : std::false_type {};
+template <template <class...> class C, class... Ts, class V>
+struct may_commit_arguments<C<Ts...>, V>
+    : std::disjunction<may_commit<Ts, V>...> {};
+
+template <class T, class V>
+struct may_commit_inner : std::false_type {};
+template <class T, class... Vs>
+struct may_commit_inner<T, visited<Vs...>>
+    : may_commit<typename T::parser_t, visited<T, Vs...>> {};
+
+template <class T, class... Vs>
+struct may_commit<T, visited<Vs...>, std::enable_if_t<std::is_class_v<T>>>
+    : std::disjunction<
+          is_commit<T>,
+          std::bool_constant<is_rule_reference_v<T> || is_bind_v<T>>,
+          may_commit_arguments<T, visited<Vs...>>,
+          std::conditional_t<has_parser_type<T>::value &&
+                                 !(std::is_same_v<T, Vs> || ...),
+                             may_commit_inner<T, visited<Vs...>>,
+                             std::false_type>> {};
+}  // namespace detail
+
+// Whether running `T` can reach a `commit` whose failure the closest
+// enclosing choice has to see. Descriptions only known at run time (rules,
+// binds) are assumed to.
+template <class T>
+constexpr static inline bool may_commit_v =
+    detail::may_commit<detail::remove_cvref_t<T>>::value;
+
+}  // namespace parsers::description
+
+#endif  // GUARD_PARSERS_DESCRIPTION_COMMIT_HPP
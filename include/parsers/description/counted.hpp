@@ -0,0 +1,49 @@
+#ifndef GUARD_PARSERS_DESCRIPTION_COUNTED_HPP
+#define GUARD_PARSERS_DESCRIPTION_COUNTED_HPP
+
+#include "./bind.hpp"
+#include "./bounded_range.hpp"
+
+#include <cstddef>
+#include <type_traits>
+
+namespace parsers::description {
+namespace detail {
+template <class P>
+struct repeat_element {
+  P element;
+
+  // Counts read as a single byte are taken as unsigned.
+  template <class N>
+  constexpr auto operator()(N n) const noexcept {
+    if constexpr (std::is_integral_v<N> && sizeof(N) == 1) {
+      return repeat<P, container<P>>{static_cast<unsigned char>(n), element};
+    }
+    else {
+      return repeat<P, container<P>>{static_cast<std::size_t>(n), element};
+    }
+  }
+};
+}  // namespace detail
+
+// A count parsed by `N`, followed by exactly that many repetitions of `P`,
+// as in length-prefixed binary formats. The result is that of the
+// repetitions.
+template <class N, class P>
+struct counted : bind<N, detail::repeat_element<P>> {
+  using base = bind<N, detail::repeat_element<P>>;
+
+  constexpr counted() noexcept = default;
+
+  template <class M, class Q>
+  constexpr counted(M&& count, Q&& element) noexcept
+      : base{std::forward<M>(count),
+             detail::repeat_element<P>{std::forward<Q>(element)}} {}
+};
+template <class N, class P>
+counted(N&&, P&&)
+    -> counted<detail::remove_cvref_t<N>, detail::remove_cvref_t<P>>;
+
+}  // namespace parsers::description
+
+#endif  // GUARD_PARSERS_DESCRIPTION_COUNTED_HPP
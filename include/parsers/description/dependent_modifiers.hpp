@@ -1,4 +1,6 @@
 #include "./bind.hpp"
+#include "./cached_bind.hpp"
+#include "./counted.hpp"
 #include "./build.hpp"
 #include "./discard.hpp"
 #include "./map.hpp"
@@ -0,0 +1,29 @@
+#ifndef GUARD_PARSERS_DESCRIPTION_LAZY_MANY_HPP
+#define GUARD_PARSERS_DESCRIPTION_LAZY_MANY_HPP
+
+#include "../utility.hpp"
+#include "./containers.hpp"
+
+namespace parsers::description {
+
+template <class P, class C = empty_container<P>>
+struct lazy_many : C {
+  constexpr lazy_many() noexcept = default;
+  template <
+      class Q,
+      std::enable_if_t<!std::is_same_v<std::decay_t<Q>, lazy_many>, int> = 0>
+  constexpr explicit lazy_many(Q&& q) : C{std::forward<Q>(q)} {}
+
+  friend constexpr std::true_type is_lazy_f(const lazy_many&) noexcept;
+};
+template <class P, class P1 = detail::remove_cvref_t<P>>
+lazy_many(P&&) -> lazy_many<P1, container<P1>>;
+
+constexpr std::false_type is_lazy_f(...) noexcept;
+template <class T>
+using is_lazy = decltype(is_lazy_f(std::declval<T>()));
+template <class T>
+constexpr static inline bool is_lazy_v = is_lazy<T>::value;
+}  // namespace parsers::description
+
+#endif  // GUARD_PARSERS_DESCRIPTION_LAZY_MANY_HPP
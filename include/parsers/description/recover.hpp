@@ -0,0 +1,58 @@
+#ifndef GUARD_PARSERS_DESCRIPTION_RECOVER_HPP
+#define GUARD_PARSERS_DESCRIPTION_RECOVER_HPP
+
+#include "../utility.hpp"
+#include "./containers.hpp"
+
+#include <cstdint>
+#include <type_traits>
+
+namespace parsers::description {
+
+// Error recovery: when `P` fails, the error is reported to the current
+// `error_log` with the id `expected`, and the input is skipped up to and
+// including the next match of `S`, or to its end. `recover` then succeeds
+// without a value, so that a repetition of records goes on after a bad one.
+template <class P, class S>
+struct recover : container<P> {
+  using base = container<P>;
+  using synchronization_t = S;
+
+  constexpr recover() noexcept = default;
+
+  template <class U, class V>
+  constexpr recover(U&& u, V&& v, std::uint32_t expected = 0) noexcept
+      : base{std::forward<U>(u)},
+        _synchronization{std::forward<V>(v)},
+        _expected{expected} {}
+
+  [[nodiscard]] constexpr const synchronization_t& synchronization()
+      const noexcept {
+    return _synchronization;
+  }
+
+  [[nodiscard]] constexpr std::uint32_t expected() const noexcept {
+    return _expected;
+  }
+
+  friend constexpr std::true_type is_recover_f(const recover&) noexcept;
+
+ private:
+  synchronization_t _synchronization{};
+  std::uint32_t _expected = 0;
+};
+template <class P, class S>
+recover(P&&, S&&) -> recover<detail::remove_cvref_t<P>, detail::remove_cvref_t<S>>;
+template <class P, class S>
+recover(P&&, S&&, std::uint32_t)
+    -> recover<detail::remove_cvref_t<P>, detail::remove_cvref_t<S>>;
+
+constexpr std::false_type is_recover_f(...) noexcept;
+template <class T>
+using is_recover = decltype(is_recover_f(std::declval<T>()));
+template <class T>
+constexpr static inline bool is_recover_v = is_recover<T>::value;
+
+}  // namespace parsers::description
+
+#endif  // GUARD_PARSERS_DESCRIPTION_RECOVER_HPP
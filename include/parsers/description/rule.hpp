@@ -0,0 +1,44 @@
+#ifndef GUARD_PARSERS_DESCRIPTION_RULE_HPP
+#define GUARD_PARSERS_DESCRIPTION_RULE_HPP
+
+#include "../utility.hpp"
+
+#include <type_traits>
+
+namespace parsers {
+template <class It, class Result>
+class rule;
+}  // namespace parsers
+
+namespace parsers::description {
+
+template <class It, class Result>
+struct rule_reference {
+  using iterator_t = It;
+  using result_type = Result;
+  using rule_t = ::parsers::rule<It, Result>;
+
+  constexpr explicit rule_reference(const rule_t& r) noexcept : _rule{&r} {}
+
+  [[nodiscard]] constexpr const rule_t& get() const noexcept { return *_rule; }
+
+  friend constexpr std::true_type is_rule_reference_f(
+      const rule_reference&) noexcept;
+
+ private:
+  const rule_t* _rule;
+};
+constexpr std::false_type is_rule_reference_f(...) noexcept;
+template <class T>
+using is_rule_reference = decltype(is_rule_reference_f(std::declval<T>()));
+template <class T>
+constexpr static inline bool is_rule_reference_v = is_rule_reference<T>::value;
+
+template <class It, class Result>
+[[nodiscard]] constexpr rule_reference<It, Result> ref(
+    const ::parsers::rule<It, Result>& r) noexcept {
+  return rule_reference<It, Result>{r};
+}
+}  // namespace parsers::description
+
+#endif  // GUARD_PARSERS_DESCRIPTION_RULE_HPP
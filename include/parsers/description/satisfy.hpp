@@ -6,9 +6,11 @@
 namespace parsers::description {
 
 namespace detail {
+using ::parsers::detail::remove_cvref_t;
+
 template <class... Ts>
 struct dynamic;
-}
+}  // namespace detail
 
 template <class CRTP>
 struct satisfy {
@@ -0,0 +1,128 @@
+#ifndef GUARD_PARSERS_DESCRIPTION_SEPARATED_HPP
+#define GUARD_PARSERS_DESCRIPTION_SEPARATED_HPP
+
+#include "../utility.hpp"
+#include "./containers.hpp"
+
+#include <cstddef>
+#include <type_traits>
+
+namespace parsers::description {
+
+// What a separated list does with a separator after its last element.
+enum class trailing {
+  forbidden,  // left unparsed
+  allowed,    // parsed if present
+  required,   // every element must be followed by a separator
+};
+
+// Elements `P` separated by `S`, at least `Min` of them. The values of the
+// separators are dropped, those of the elements are put in a single vector,
+// or folded by `F` when it isn't void. `F` is then a stateless function
+// object: `F{}()` gives the initial value, `F{}(acc, element)` the next one.
+template <class P, class S, std::size_t Min, trailing T, class F = void>
+struct separated : container<P> {
+  using base = container<P>;
+  using separator_t = S;
+  using fold_t = F;
+
+  constexpr static inline std::size_t minimum = Min;
+  constexpr static inline trailing trailing_separator = T;
+
+  static_assert(std::is_void_v<F> || (std::is_empty_v<F> &&
+                                      std::is_default_constructible_v<F>),
+                "the fold of a separated list must be stateless");
+
+  constexpr separated() noexcept = default;
+
+  template <class U, class V>
+  constexpr separated(U&& u, V&& v) noexcept
+      : base{std::forward<U>(u)}, _separator{std::forward<V>(v)} {}
+
+  [[nodiscard]] constexpr const separator_t& separator() const noexcept {
+    return _separator;
+  }
+
+  friend constexpr std::true_type is_separated_f(const separated&) noexcept;
+
+ private:
+  separator_t _separator{};
+};
+
+constexpr std::false_type is_separated_f(...) noexcept;
+template <class T>
+using is_separated = decltype(is_separated_f(std::declval<T>()));
+template <class T>
+constexpr static inline bool is_separated_v = is_separated<T>::value;
+
+template <class T, class = void>
+struct folds : std::false_type {};
+template <class T>
+struct folds<T, std::enable_if_t<is_separated_v<T>>>
+    : std::negation<std::is_void<typename T::fold_t>> {};
+template <class T>
+constexpr static inline bool folds_v = folds<T>::value;
+
+// 0 or more `P` separated by `S`.
+template <class P, class S, trailing T = trailing::forbidden>
+struct sep_by : separated<P, S, 0, T> {
+  using base = separated<P, S, 0, T>;
+
+  constexpr sep_by() noexcept = default;
+
+  template <class U, class V>
+  constexpr sep_by(U&& u, V&& v) noexcept
+      : base{std::forward<U>(u), std::forward<V>(v)} {}
+};
+template <class P, class S>
+sep_by(P&&, S&&)
+    -> sep_by<detail::remove_cvref_t<P>, detail::remove_cvref_t<S>>;
+
+// 1 or more `P` separated by `S`.
+template <class P, class S, trailing T = trailing::forbidden>
+struct sep_by1 : separated<P, S, 1, T> {
+  using base = separated<P, S, 1, T>;
+
+  constexpr sep_by1() noexcept = default;
+
+  template <class U, class V>
+  constexpr sep_by1(U&& u, V&& v) noexcept
+      : base{std::forward<U>(u), std::forward<V>(v)} {}
+};
+template <class P, class S>
+sep_by1(P&&, S&&)
+    -> sep_by1<detail::remove_cvref_t<P>, detail::remove_cvref_t<S>>;
+
+// 0 or more `P`, each followed by `S`.
+template <class P, class S>
+struct end_by : separated<P, S, 0, trailing::required> {
+  using base = separated<P, S, 0, trailing::required>;
+
+  constexpr end_by() noexcept = default;
+
+  template <class U, class V>
+  constexpr end_by(U&& u, V&& v) noexcept
+      : base{std::forward<U>(u), std::forward<V>(v)} {}
+};
+template <class P, class S>
+end_by(P&&, S&&)
+    -> end_by<detail::remove_cvref_t<P>, detail::remove_cvref_t<S>>;
+
+// Same as `sep_by`, the elements being folded by `F` instead of collected.
+template <class P, class S, class F, trailing T = trailing::forbidden>
+struct fold_sep_by : separated<P, S, 0, T, F> {
+  using base = separated<P, S, 0, T, F>;
+
+  constexpr fold_sep_by() noexcept = default;
+
+  template <class U, class V>
+  constexpr fold_sep_by(U&& u, V&& v, [[maybe_unused]] F f = F{}) noexcept
+      : base{std::forward<U>(u), std::forward<V>(v)} {}
+};
+template <class P, class S, class F>
+fold_sep_by(P&&, S&&, F)
+    -> fold_sep_by<detail::remove_cvref_t<P>, detail::remove_cvref_t<S>, F>;
+
+}  // namespace parsers::description
+
+#endif  // GUARD_PARSERS_DESCRIPTION_SEPARATED_HPP
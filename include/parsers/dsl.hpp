@@ -47,6 +47,23 @@ template <class T>
 constexpr static inline auto make_index_sequence =
     dpsg::feed_t<std::decay_t<T>, std::index_sequence_for>{};
 
+template <class T, class U = parsers::detail::remove_cvref_t<T>>
+constexpr static inline bool is_description_v =
+    parsers::description::is_satisfiable_predicate_v<U> ||
+    parsers::description::is_sequence_v<U> ||
+    parsers::description::is_alternative_v<U> ||
+    parsers::description::is_dynamic_range_v<U> ||
+    parsers::description::is_bounded_range_v<U> ||
+    parsers::description::is_separated_v<U> ||
+    parsers::description::is_modifier_v<U> ||
+    parsers::description::is_recursive_v<U> ||
+    parsers::description::is_guard_v<U> ||
+    parsers::description::is_commit_v<U> ||
+    parsers::description::is_recover_v<U> ||
+    parsers::description::is_bind_v<U> ||
+    parsers::description::is_lazy_v<U> ||
+    parsers::description::is_rule_reference_v<U>;
+
 }  // namespace detail
 
 template <class A,
@@ -129,6 +146,19 @@ template <class A,
       detail::make_index_sequence<B>);
 }
 
+// `left > right`: `left` then `right`, committing to the branch once `left`
+// matched (see `description::commit`). The cut covers the rest of the branch,
+// a failure of `c` in `a > b & c` is fatal as well.
+template <class A,
+          class B,
+          std::enable_if_t<detail::is_description_v<A> ||
+                               detail::is_description_v<B>,
+                           int> = 0>
+[[nodiscard]] constexpr auto operator>(A&& left, B&& right) noexcept {
+  return std::forward<A>(left) &
+         description::commit{std::forward<B>(right)};
+}
+
 constexpr description::dynamic_character<char> operator""_c(char c) noexcept {
   return description::dynamic_character<char>(c);
 }
@@ -0,0 +1,321 @@
+#ifndef GUARD_PARSERS_FURTHEST_FAILURE_HPP
+#define GUARD_PARSERS_FURTHEST_FAILURE_HPP
+
+#include "./interpreters.hpp"
+#include "./result_traits.hpp"
+#include "./utility.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace parsers {
+
+class byte_set {
+ public:
+  constexpr void insert(unsigned char c) noexcept {
+    _words[c / 64] |= std::uint64_t{1} << (c % 64);
+  }
+
+  [[nodiscard]] constexpr bool contains(unsigned char c) const noexcept {
+    return (_words[c / 64] >> (c % 64)) & 1;
+  }
+
+  [[nodiscard]] constexpr std::size_t size() const noexcept {
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < 256; ++i) {
+      count += contains(static_cast<unsigned char>(i)) ? 1 : 0;
+    }
+    return count;
+  }
+
+  [[nodiscard]] constexpr bool empty() const noexcept {
+    return (_words[0] | _words[1] | _words[2] | _words[3]) == 0;
+  }
+
+  constexpr byte_set& operator|=(const byte_set& other) noexcept {
+    for (std::size_t i = 0; i < 4; ++i) {
+      _words[i] |= other._words[i];
+    }
+    return *this;
+  }
+
+  friend constexpr bool operator==(const byte_set& left,
+                                   const byte_set& right) noexcept {
+    for (std::size_t i = 0; i < 4; ++i) {
+      if (left._words[i] != right._words[i]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+ private:
+  std::uint64_t _words[4]{};
+};
+
+// The furthest position at which a terminal description (a character, a
+// string, a guard...) failed, and what the terminals failing there expected:
+// the bytes they could have started with, and whether one of them was `end`.
+// Positions are kept as distances to the end of the input.
+class furthest_failure {
+ public:
+  constexpr static inline std::size_t none =
+      std::numeric_limits<std::size_t>::max();
+
+  [[nodiscard]] bool empty() const noexcept { return _remaining == none; }
+
+  [[nodiscard]] std::size_t remaining() const noexcept { return _remaining; }
+
+  // Offset of the failure in an input of `length` elements.
+  [[nodiscard]] std::size_t offset(std::size_t length) const noexcept {
+    return length - _remaining;
+  }
+
+  [[nodiscard]] const byte_set& expected() const noexcept { return _expected; }
+
+  [[nodiscard]] bool expects_end() const noexcept { return _end; }
+
+  void clear() noexcept { *this = furthest_failure{}; }
+
+  // Whether a failure `remaining` elements from the end would be kept.
+  [[nodiscard]] bool reaches(std::size_t remaining) const noexcept {
+    return remaining <= _remaining;
+  }
+
+  void fail(std::size_t remaining, const byte_set& expected, bool end) noexcept {
+    if (remaining < _remaining) {
+      _remaining = remaining;
+      _expected = expected;
+      _end = end;
+    }
+    else if (remaining == _remaining) {
+      _expected |= expected;
+      _end = _end || end;
+    }
+  }
+
+ private:
+  std::size_t _remaining = none;
+  byte_set _expected;
+  bool _end = false;
+};
+
+namespace detail {
+template <class T>
+constexpr std::true_type is_ascii_description_f(
+    const description::ascii::character_class<T>&) noexcept;
+template <auto C, class T>
+constexpr std::true_type is_ascii_description_f(
+    const description::ascii::case_insensitive_character<C, T>&) noexcept;
+constexpr std::false_type is_ascii_description_f(...) noexcept;
+
+// The bytes a terminal accepts first, found by trying it on each of them.
+// The ascii classes are only defined up to 127.
+template <class D>
+constexpr byte_set expected_bytes(const D& desc) noexcept {
+  byte_set set;
+  if constexpr (description::is_satisfiable_predicate_v<D>) {
+    constexpr std::size_t size =
+        decltype(is_ascii_description_f(desc))::value ? 128 : 256;
+    for (std::size_t i = 0; i < size; ++i) {
+      const char input[1] = {static_cast<char>(i)};
+      if (desc.check(input + 0, input + 1) != input + 0) {
+        set.insert(static_cast<unsigned char>(i));
+      }
+    }
+  }
+  return set;
+}
+
+template <class T>
+constexpr byte_set expected_bytes(
+    const description::dynamic_character<T>& desc) noexcept {
+  byte_set set;
+  set.insert(static_cast<unsigned char>(desc.value()));
+  return set;
+}
+
+template <class D>
+constexpr static inline byte_set static_expected_bytes = expected_bytes(D{});
+
+template <class P, class = void>
+struct has_predicate : std::false_type {};
+template <class P>
+struct has_predicate<P, std::void_t<decltype(std::declval<const P&>().pred)>>
+    : std::true_type {};
+
+template <class D>
+constexpr static inline bool is_terminal_v =
+    description::is_satisfiable_predicate_v<D> || description::is_guard_v<D>;
+
+template <class D>
+constexpr static inline bool is_static_string_v =
+    dpsg::is_template_instance_v<D, description::static_string>;
+
+// Wraps the parser of a terminal: on the success path it only adds the test
+// the caller makes anyway, failures compare their position with the furthest
+// one before computing what was expected.
+template <class D, class P>
+struct failure_tracking_parser {
+  P parser;
+  furthest_failure* target;
+
+  template <class ItB, class ItE>
+  constexpr auto operator()(ItB begin, ItE end) const
+      -> decltype(parser(begin, end)) {
+    auto result = parser(begin, end);
+    if constexpr (std::is_same_v<ItB, ItE>) {
+      if (!has_value(result)) {
+        if constexpr (is_static_string_v<D> && has_predicate<P>::value) {
+          record_string(begin, end);
+        }
+        else {
+          const auto remaining =
+              static_cast<std::size_t>(std::distance(begin, end));
+          if (target->reaches(remaining)) {
+            target->fail(remaining,
+                         expected<remove_cvref_t<decltype(*begin)>>(),
+                         std::is_same_v<D, description::end_t>);
+          }
+        }
+      }
+    }
+    return result;
+  }
+
+ private:
+  // A string fails where it stops matching the input, expecting the
+  // character it has there.
+  template <class It>
+  void record_string(It it, It end) const {
+    using value_t = remove_cvref_t<decltype(*it)>;
+    auto c = parser.pred.begin();
+    while (c != parser.pred.end() && it != end && *it == *c) {
+      ++it;
+      ++c;
+    }
+    const auto remaining = static_cast<std::size_t>(std::distance(it, end));
+    if (target->reaches(remaining)) {
+      byte_set expected;
+      if constexpr (sizeof(value_t) == 1 && std::is_integral_v<value_t>) {
+        if (c != parser.pred.end()) {
+          expected.insert(static_cast<unsigned char>(*c));
+        }
+      }
+      target->fail(remaining, expected, false);
+    }
+  }
+
+  template <class V>
+  byte_set expected() const noexcept {
+    if constexpr (sizeof(V) != 1 || !std::is_integral_v<V>) {
+      return {};
+    }
+    else if constexpr (std::is_empty_v<D> &&
+                       std::is_default_constructible_v<D>) {
+      return static_expected_bytes<D>;
+    }
+    else if constexpr (has_predicate<P>::value) {
+      return expected_bytes(parser.pred);
+    }
+    else {
+      return {};
+    }
+  }
+};
+
+template <class D, class J>
+struct retargeted_modifier : D {
+  J retargeted;
+
+  [[nodiscard]] constexpr const J& interpreter() const noexcept {
+    return retargeted;
+  }
+};
+}  // namespace detail
+
+// Wraps an interpreter so that each terminal it runs records its failures in
+// a `furthest_failure`. Descriptions are run through the combinators (no
+// automaton, no merged characters) and the descriptions of modifiers are run
+// by a tracking version of their own interpreter, so that every terminal is
+// seen. With `Enabled` false, nothing is recorded and the parsers are those
+// of `Interpreter`.
+template <class Interpreter, bool Enabled = true>
+struct tracking_failures : Interpreter {
+  constexpr static inline bool instruments = Enabled;
+  constexpr static inline bool ignores_structure = false;
+
+  constexpr explicit tracking_failures(furthest_failure& target) noexcept
+      : _target{&target} {}
+
+  template <class D, class F>
+  auto instrument([[maybe_unused]] type_t<D> description, F&& build) const {
+    auto parser = std::forward<F>(build)();
+    if constexpr (detail::is_terminal_v<D>) {
+      return detail::failure_tracking_parser<D, decltype(parser)>{
+          std::move(parser), _target};
+    }
+    else {
+      return parser;
+    }
+  }
+
+  template <class I,
+            class D,
+            class ItB,
+            class ItE,
+            class D1 = detail::remove_cvref_t<D>>
+  static auto modify(type_t<D1> tag,
+                     I&& interpreter,
+                     D&& description,
+                     ItB begin,
+                     ItE end) {
+    using inner_t =
+        tracked<detail::remove_cvref_t<decltype(description.interpreter())>>;
+    return Interpreter::modify(
+        tag,
+        std::forward<I>(interpreter),
+        detail::retargeted_modifier<D1, typename inner_t::type>{
+            std::forward<D>(description), inner_t::make(interpreter.target())},
+        begin,
+        end);
+  }
+
+  [[nodiscard]] furthest_failure& target() const noexcept { return *_target; }
+
+ private:
+  template <class T>
+  struct tracked;
+  template <class T>
+  struct tracked<interpreters::make_parser_t<T>> {
+    using type = interpreters::make_parser_t<tracking_failures<T>>;
+
+    static type make(furthest_failure& target) noexcept {
+      return type{tracking_failures<T>{target}};
+    }
+  };
+
+  furthest_failure* _target;
+};
+
+template <class Interpreter>
+struct tracking_failures<Interpreter, false> : Interpreter {
+  constexpr explicit tracking_failures(
+      [[maybe_unused]] furthest_failure& target) noexcept {}
+};
+
+template <class Interpreter, bool Enabled = true, class Description>
+[[nodiscard]] auto make_failure_tracking_parser(Description&& desc,
+                                                furthest_failure& target) {
+  return interpreters::make_parser_t<tracking_failures<Interpreter, Enabled>>{
+      tracking_failures<Interpreter, Enabled>{target}}(
+      std::forward<Description>(desc));
+}
+
+}  // namespace parsers
+
+#endif  // GUARD_PARSERS_FURTHEST_FAILURE_HPP
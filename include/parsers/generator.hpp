@@ -0,0 +1,229 @@
+#ifndef GUARD_PARSERS_GENERATOR_HPP
+#define GUARD_PARSERS_GENERATOR_HPP
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#include "./interpreter_traits.hpp"
+#include "./interpreters.hpp"
+#include "./result_traits.hpp"
+#include "./utility.hpp"
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace parsers {
+
+template <class T, class Allocator = std::allocator<std::byte>>
+class generator {
+ public:
+  using value_type = T;
+
+  // Yielded by a coroutine to end the generation as a failure.
+  struct failure_t {};
+
+  struct promise_type {
+    using allocator_t = typename std::allocator_traits<
+        Allocator>::template rebind_alloc<std::byte>;
+
+    [[nodiscard]] generator get_return_object() noexcept {
+      return generator{handle_t::from_promise(*this)};
+    }
+    [[nodiscard]] std::suspend_always initial_suspend() const noexcept {
+      return {};
+    }
+    [[nodiscard]] std::suspend_always final_suspend() const noexcept {
+      return {};
+    }
+    std::suspend_always yield_value(value_type& value) noexcept {
+      _current = std::addressof(value);
+      return {};
+    }
+    std::suspend_always yield_value(value_type&& value) noexcept {
+      _current = std::addressof(value);
+      return {};
+    }
+    std::suspend_never yield_value([[maybe_unused]] failure_t f) noexcept {
+      _failed = true;
+      return {};
+    }
+    void return_void() const noexcept {}
+    void unhandled_exception() { throw; }
+
+    template <class... Args>
+    static void* operator new(std::size_t size,
+                              [[maybe_unused]] std::allocator_arg_t tag,
+                              const Allocator& allocator,
+                              [[maybe_unused]] const Args&... args) {
+      allocator_t alloc{allocator};
+      std::byte* frame =
+          std::allocator_traits<allocator_t>::allocate(alloc, padded(size));
+      ::new (static_cast<void*>(frame + allocator_offset(size)))
+          allocator_t{std::move(alloc)};
+      return frame;
+    }
+
+    static void* operator new(std::size_t size) {
+      return operator new(size, std::allocator_arg, Allocator{});
+    }
+
+    static void operator delete(void* ptr, std::size_t size) noexcept {
+      auto* frame = static_cast<std::byte*>(ptr);
+      auto* stored =
+          std::launder(reinterpret_cast<allocator_t*>(  // NOLINT
+              frame + allocator_offset(size)));
+      allocator_t alloc{std::move(*stored)};
+      stored->~allocator_t();
+      std::allocator_traits<allocator_t>::deallocate(
+          alloc, frame, padded(size));
+    }
+
+   private:
+    friend class generator;
+
+    [[nodiscard]] static constexpr std::size_t allocator_offset(
+        std::size_t size) noexcept {
+      constexpr std::size_t align = alignof(allocator_t);
+      return (size + align - 1) / align * align;
+    }
+    [[nodiscard]] static constexpr std::size_t padded(
+        std::size_t size) noexcept {
+      return allocator_offset(size) + sizeof(allocator_t);
+    }
+
+    value_type* _current = nullptr;
+    bool _failed = false;
+  };
+  using handle_t = std::coroutine_handle<promise_type>;
+
+  struct sentinel {};
+
+  struct iterator {
+    using value_type = typename generator::value_type;
+    using reference = value_type&;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::input_iterator_tag;
+
+    [[nodiscard]] reference operator*() const noexcept {
+      return *_handle.promise()._current;
+    }
+    iterator& operator++() {
+      _handle.resume();
+      return *this;
+    }
+    void operator++(int) { ++*this; }
+
+    [[nodiscard]] friend bool operator==(const iterator& it,
+                                         [[maybe_unused]] sentinel s) noexcept {
+      return it._handle.done();
+    }
+
+    handle_t _handle;
+  };
+
+  generator(generator&& other) noexcept
+      : _handle{std::exchange(other._handle, nullptr)} {}
+  generator& operator=(generator&& other) noexcept {
+    if (this != &other) {
+      _destroy();
+      _handle = std::exchange(other._handle, nullptr);
+    }
+    return *this;
+  }
+  generator(const generator&) = delete;
+  generator& operator=(const generator&) = delete;
+  ~generator() { _destroy(); }
+
+  [[nodiscard]] iterator begin() {
+    _handle.resume();
+    return iterator{_handle};
+  }
+  [[nodiscard]] sentinel end() const noexcept { return {}; }
+
+  // Whether the generation ended as a failure, once the end is reached.
+  [[nodiscard]] bool failed() const noexcept {
+    return _handle && _handle.promise()._failed;
+  }
+
+ private:
+  explicit generator(handle_t handle) noexcept : _handle{handle} {}
+
+  void _destroy() noexcept {
+    if (_handle) {
+      _handle.destroy();
+    }
+  }
+
+  handle_t _handle;
+};
+
+namespace detail {
+template <class T, class Allocator, class Parser, class ItB, class ItE>
+generator<T, Allocator> generate_elements(
+    [[maybe_unused]] std::allocator_arg_t tag,
+    [[maybe_unused]] const Allocator& allocator,
+    Parser parser,
+    std::size_t minimum,
+    ItB beg,
+    ItE end) {
+  std::size_t count = 0;
+  while (beg != end) {
+    auto r = parser(beg, end);
+    if (!parsers::has_value(r)) {
+      break;
+    }
+    beg = parsers::next_iterator(r);
+    ++count;
+    co_yield parsers::value(std::move(r));
+  }
+  if (count < minimum) {
+    co_yield typename generator<T, Allocator>::failure_t{};
+  }
+}
+
+template <class Description, class It>
+using generated_t = parsers::interpreter_value_type<
+    interpreters::object_parser,
+    It,
+    typename std::decay_t<Description>::parser_t>;
+}  // namespace detail
+
+template <class Allocator, class Description, class T>
+[[nodiscard]] auto generate(std::allocator_arg_t tag,
+                            const Allocator& allocator,
+                            Description&& desc,
+                            const T& input) {
+  static_assert(description::is_dynamic_range_v<std::decay_t<Description>>,
+                "generate expects a many or at_least description");
+  using std::begin;
+  using std::end;
+  using iterator = decltype(begin(input));
+  using value_t = detail::generated_t<Description, iterator>;
+  const std::size_t minimum = desc.count();
+  return detail::generate_elements<value_t, Allocator>(
+      tag,
+      allocator,
+      interpreters::make_parser<interpreters::object_parser>(
+          std::forward<Description>(desc).parser()),
+      minimum,
+      begin(input),
+      end(input));
+}
+
+template <class Description, class T>
+[[nodiscard]] auto generate(Description&& desc, const T& input) {
+  return generate(std::allocator_arg,
+                  std::allocator<std::byte>{},
+                  std::forward<Description>(desc),
+                  input);
+}
+
+}  // namespace parsers
+
+#endif  // defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#endif  // GUARD_PARSERS_GENERATOR_HPP
@@ -1,4 +1,5 @@
 #include "./interpreters/make_parser.hpp"
 #include "./interpreters/matcher.hpp"
 #include "./interpreters/object_parser.hpp"
-#include "./interpreters/range_parser.hpp"
\ No newline at end of file
+#include "./interpreters/range_parser.hpp"
+#include "./interpreters/sizer.hpp"
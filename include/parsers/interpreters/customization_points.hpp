@@ -2,10 +2,22 @@
 #define PARSERS_CUSTOMIZATION_POINTS_HPP
 
 #include "../description.hpp"
+#include "../optimize.hpp"
+#include "../recovery.hpp"
 #include "../utility.hpp"
 
 #include "../result_traits.hpp"
 
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
 namespace parsers::customization_points {
 namespace detail {
 using namespace ::parsers::detail;
@@ -51,6 +63,87 @@ template <class I, class T, std::size_t S, class... Args>
       type<detail::remove_cvref_t<T>>, std::forward<Args>(args)...);
 }
 
+// Interpreters may follow the repetitions through
+// `begin_repetition(type<M>, acc)`, called with the empty result before the
+// first element, and `end_repetition(type<M>, token, count)`, called with
+// what `begin_repetition` returned once the repetition stops.
+template <class I, class M, class Acc, class = void>
+struct follows_repetitions : std::false_type {};
+template <class I, class M, class Acc>
+struct follows_repetitions<
+    I,
+    M,
+    Acc,
+    std::void_t<decltype(std::decay_t<I>::begin_repetition(
+        type<M>,
+        std::declval<Acc&>()))>> : std::true_type {};
+
+template <class I, class M, class Acc>
+constexpr auto begin_repetition([[maybe_unused]] Acc& acc) {
+  if constexpr (follows_repetitions<I, M, Acc>::value) {
+    return std::decay_t<I>::begin_repetition(type<M>, acc);
+  }
+  else {
+    return empty{};
+  }
+}
+
+template <class I, class M, class Token>
+constexpr void end_repetition([[maybe_unused]] Token&& token,
+                              [[maybe_unused]] std::size_t count) {
+  if constexpr (!std::is_same_v<remove_cvref_t<Token>, empty>) {
+    std::decay_t<I>::end_repetition(type<M>, std::forward<Token>(token), count);
+  }
+}
+
+// Interpreters may also reserve room for the elements of a repetition whose
+// size is bounded, through `reserve_repetition(type<M>, acc, n)`.
+template <class I, class M, class Acc, class = void>
+struct reserves_repetitions : std::false_type {};
+template <class I, class M, class Acc>
+struct reserves_repetitions<
+    I,
+    M,
+    Acc,
+    std::void_t<decltype(std::decay_t<I>::reserve_repetition(
+        type<M>,
+        std::declval<Acc&>(),
+        std::size_t{}))>> : std::true_type {};
+
+template <class I, class M, class Acc>
+constexpr void reserve_repetition([[maybe_unused]] Acc& acc,
+                                  [[maybe_unused]] std::size_t n) {
+  if constexpr (reserves_repetitions<I, M, Acc>::value) {
+    std::decay_t<I>::reserve_repetition(type<M>, acc, n);
+  }
+}
+
+// Interpreters whose results hold a value defining `extend(type<M>, result,
+// position)` move the end of a successful `result` to `position`, keeping its
+// value. The others get a new result.
+template <class I, class M, class R, class It, class = void>
+struct extends_results : std::false_type {};
+template <class I, class M, class R, class It>
+struct extends_results<
+    I,
+    M,
+    R,
+    It,
+    std::void_t<decltype(std::decay_t<I>::extend(type<M>,
+                                                 std::declval<R>(),
+                                                 std::declval<It>()))>>
+    : std::true_type {};
+
+template <class I, class M, class R, class ItB, class ItE>
+constexpr auto extend(R&& result, ItB begin, ItB position, ItE end) {
+  if constexpr (extends_results<I, M, R, ItB>::value) {
+    return std::decay_t<I>::extend(type<M>, std::forward<R>(result), position);
+  }
+  else {
+    return detail::success<I, M>(begin, position, end);
+  }
+}
+
 template <class D, class I>
 struct parser_indirection_t {
   using parser_t = D;
@@ -81,6 +174,60 @@ struct parser_indirection_t {
   }
 };
 
+// Set once the parser reaches a `commit`, until the closest enclosing choice
+// sees it: any failure of the branch after that point is fatal for the
+// choice. Choices only look at it for the branches that may commit.
+inline bool& committed_branch() noexcept {
+  thread_local bool committed = false;
+  return committed;
+}
+
+// Callable from constexpr parsers, the flag can't be reached during constant
+// evaluation: commits are then ignored and choices backtrack as usual.
+#if defined(__cpp_lib_is_constant_evaluated)
+constexpr bool* active_committed_branch() noexcept {
+  if (std::is_constant_evaluated()) {
+    return nullptr;
+  }
+  return &committed_branch();
+}
+#else
+inline bool* active_committed_branch() noexcept {
+  return &committed_branch();
+}
+#endif
+
+// A branch of a choice: the state of the enclosing branch is put aside when
+// it is entered, and restored when it is left. The mandatory elements of a
+// repetition aren't a choice, they are not entered and their commits belong
+// to the enclosing branch.
+template <bool MayCommit>
+struct choice_branch {
+  constexpr explicit choice_branch([[maybe_unused]] bool enter = true) noexcept {
+    if constexpr (MayCommit) {
+      if (enter) {
+        committed = active_committed_branch();
+        if (committed != nullptr) {
+          outer = std::exchange(*committed, false);
+        }
+      }
+    }
+  }
+
+  // Whether the branch reached a `commit`.
+  constexpr bool leave() noexcept {
+    if constexpr (MayCommit) {
+      if (committed != nullptr) {
+        return std::exchange(*std::exchange(committed, nullptr), outer);
+      }
+    }
+    return false;
+  }
+
+  bool* committed = nullptr;
+  bool outer = false;
+};
+
 template <class G, class I>
 struct guard_parser {
   G guard;
@@ -110,22 +257,54 @@ struct predicate_parser {
 
 template <class M, class I, class P>
 struct dynamic_range_parser {
+  constexpr static inline bool may_commit =
+      description::may_commit_v<typename M::parser_t>;
+
   std::size_t expected;
   P parser;
   template <class T, class U>
   constexpr auto operator()(T beg, U end) const noexcept
       -> detail::result_t<I, decltype(beg), M> {
+    if constexpr (detail::ignores_structure<I>::value) {
+      // The result only depends on where the repetition stops, skip the
+      // accumulator.
+      std::size_t count = 0;
+      const auto b = beg;
+      while (beg != end) {
+        detail::choice_branch<may_commit> branch{count >= expected};
+        auto r = parser(beg, end);
+        if (branch.leave() && !has_value(r)) {
+          return detail::failure<I, M>(b, beg, end);
+        }
+        if (!has_value(r)) {
+          break;
+        }
+        beg = next_iterator(std::move(r));
+        ++count;
+      }
+      if (count >= expected) {
+        return detail::success<I, M>(b, beg, end);
+      }
+      return detail::failure<I, M>(b, beg, end);
+    }
     auto acc = detail::success<I, M>(beg, beg, end);
+    auto repetition = detail::begin_repetition<I, M>(acc);
     std::size_t count = 0;
     auto b = beg;
     while (beg != end) {
+      detail::choice_branch<may_commit> branch{count >= expected};
       auto r = detail::combine<I, M>(acc, parser(beg, end));
+      if (branch.leave() && !has_value(r)) {
+        detail::end_repetition<I, M>(std::move(repetition), count);
+        return detail::failure<I, M>(b, beg, end);
+      }
       if (!has_value(r)) {
         break;
       }
       beg = next_iterator(std::move(r));
       ++count;
     }
+    detail::end_repetition<I, M>(std::move(repetition), count);
     if (count >= expected) {
       return acc;
     }
@@ -133,25 +312,325 @@ struct dynamic_range_parser {
   }
 };
 
-template <std::size_t S, class D, class I, class ItB, class ItE, class... Args>
+// Number of elements of the bounded repetitions whose exact count is known at
+// compile time, `not_exact` for the others.
+constexpr static inline std::size_t not_exact =
+    std::numeric_limits<std::size_t>::max();
+template <class B>
+constexpr static inline std::size_t exact_count = not_exact;
+template <std::size_t N>
+constexpr static inline std::size_t
+    exact_count<description::detail::static_bounds<N, N>> = N;
+
+template <class M, class I, class P>
+struct bounded_range_parser {
+  using bounds_t = typename M::bounds_t;
+
+  constexpr static inline bool may_commit =
+      description::may_commit_v<typename M::parser_t>;
+  // Exact counts known at compile time up to this size are unrolled.
+  constexpr static inline std::size_t unrolled = 8;
+  // At most this many elements are reserved: the bounds may come from the
+  // input, and are only trusted as far as the elements actually parsed.
+  constexpr static inline std::size_t reserved = 64;
+
+  bounds_t bounds;
+  P parser;
+
+  template <class T, class U>
+  constexpr auto operator()(T beg, U end) const noexcept
+      -> detail::result_t<I, decltype(beg), M> {
+    auto acc = detail::success<I, M>(beg, beg, end);
+    auto repetition = detail::begin_repetition<I, M>(acc);
+    const auto min = bounds.minimum();
+    const auto max = bounds.maximum();
+    detail::reserve_repetition<I, M>(
+        acc, max <= reserved ? max : (min < reserved ? min : reserved));
+
+    const auto b = beg;
+    std::size_t count = 0;
+    bool aborted = false;
+    const auto step = [&] {
+      if (beg == end) {
+        return false;
+      }
+      detail::choice_branch<may_commit> branch{count >= min};
+      auto r = [&] {
+        if constexpr (detail::ignores_structure<I>::value) {
+          return parser(beg, end);
+        }
+        else {
+          return detail::combine<I, M>(acc, parser(beg, end));
+        }
+      }();
+      aborted = branch.leave() && !has_value(r);
+      if (!has_value(r)) {
+        return false;
+      }
+      beg = next_iterator(std::move(r));
+      ++count;
+      return true;
+    };
+    if constexpr (exact_count<bounds_t> <= unrolled) {
+      unroll(step, std::make_index_sequence<exact_count<bounds_t>>{});
+    }
+    else {
+      while (count < max && step()) {
+      }
+    }
+
+    // Below the minimum, commits are left for the enclosing choice.
+    const bool failed = aborted || count < min;
+    detail::end_repetition<I, M>(std::move(repetition), count);
+    if (failed) {
+      return detail::failure<I, M>(b, beg, end);
+    }
+    if constexpr (detail::ignores_structure<I>::value) {
+      return detail::success<I, M>(b, beg, end);
+    }
+    else {
+      return acc;
+    }
+  }
+
+ private:
+  template <class F, std::size_t... Is>
+  constexpr static void unroll(const F& step,
+                               [[maybe_unused]] std::index_sequence<Is...>) {
+    static_cast<void>(((static_cast<void>(Is), step()) && ...));
+  }
+};
+
+template <class M, class I, class P, class S>
+struct separated_parser {
+  constexpr static inline bool may_commit =
+      description::may_commit_v<typename M::parser_t> ||
+      description::may_commit_v<typename M::separator_t>;
+  constexpr static inline auto trailing = M::trailing_separator;
+
+  P parser;
+  S separator;
+
+  template <class T, class U>
+  constexpr auto operator()(T beg, U end) const noexcept
+      -> detail::result_t<I, decltype(beg), M> {
+    auto acc = detail::success<I, M>(beg, beg, end);
+    auto repetition = detail::begin_repetition<I, M>(acc);
+    const auto b = beg;
+    std::size_t count = 0;
+    bool aborted = false;
+    // Where the list ends if what comes next fails: after the last element,
+    // or after its separator when trailing separators are allowed.
+    auto stop = beg;
+    // The branches of the list are its elements with the separator before
+    // them (or after them when it is required), the first one alone.
+    detail::choice_branch<may_commit> branch{M::minimum == 0};
+    while (beg != end) {
+      auto r = parser(beg, end);
+      if (!has_value(r)) {
+        aborted = branch.leave();
+        break;
+      }
+      const auto after = next_iterator(r);
+      if constexpr (trailing == description::trailing::required) {
+        const auto s = separator(after, end);
+        if (!has_value(s)) {
+          aborted = branch.leave();
+          break;
+        }
+        beg = stop = next_iterator(s);
+      }
+      else {
+        beg = stop = after;
+      }
+      if constexpr (!detail::ignores_structure<I>::value) {
+        detail::combine<I, M>(acc, std::move(r));
+      }
+      ++count;
+      branch.leave();
+      branch = detail::choice_branch<may_commit>{count >= M::minimum};
+      if constexpr (trailing != description::trailing::required) {
+        if (beg == end) {
+          break;
+        }
+        const auto s = separator(beg, end);
+        if (!has_value(s)) {
+          aborted = branch.leave();
+          break;
+        }
+        beg = next_iterator(s);
+        if constexpr (trailing == description::trailing::allowed) {
+          stop = beg;
+        }
+      }
+    }
+    branch.leave();
+
+    detail::end_repetition<I, M>(std::move(repetition), count);
+    if (aborted || count < M::minimum) {
+      return detail::failure<I, M>(b, beg, end);
+    }
+    if constexpr (detail::ignores_structure<I>::value) {
+      return detail::success<I, M>(b, stop, end);
+    }
+    else {
+      return detail::extend<I, M>(std::move(acc), b, stop, end);
+    }
+  }
+};
+
+template <class D, class I, class It, class = void>
+struct has_commit : std::false_type {};
+template <class D, class I, class It>
+struct has_commit<
+    D,
+    I,
+    It,
+    std::void_t<decltype(I::commit(type<D>, std::declval<It>()))>>
+    : std::true_type {};
+
+// Interpreters defining `commit(type<D>, position)` learn that the closest
+// enclosing choice will not try another branch once `position` is reached,
+// and may drop what they keep to backtrack there.
+template <class D, class I, class P>
+struct commit_parser {
+  P parser;
+
+  template <class ItB, class ItE>
+  constexpr auto operator()(ItB begin, ItE end) const noexcept
+      -> decltype(parser(begin, end)) {
+    if constexpr (has_commit<D, I, ItB>::value) {
+      I::commit(type<D>, begin);
+    }
+    if (bool* committed = active_committed_branch(); committed != nullptr) {
+      *committed = true;
+    }
+    return parser(begin, end);
+  }
+};
+
+template <class D, class I, class R, class = void>
+struct has_recover : std::false_type {};
+template <class D, class I, class R>
+struct has_recover<
+    D,
+    I,
+    R,
+    std::void_t<decltype(I::recover(type<D>, std::declval<R>()))>>
+    : std::true_type {};
+
+// Interpreters defining `recover(type<D>, result)` turn a success of the
+// inner description into the result of `recover`, the others return it as
+// is. The synchronization is matched through `discard`, skipping a bad input
+// builds nothing.
+template <class D, class I, class P, class S>
+struct recover_parser {
+  constexpr static inline bool may_commit =
+      description::may_commit_v<typename D::parser_t>;
+
+  P parser;
+  S synchronization;
+  std::uint32_t expected;
+
+  template <class ItB, class ItE>
+  constexpr auto operator()(ItB begin, ItE end) const noexcept
+      -> detail::result_t<I, ItB, D> {
+    // Skipping the input is the other branch, commits stop there.
+    detail::choice_branch<may_commit> branch;
+    auto r = parser(begin, end);
+    branch.leave();
+    if (has_value(r)) {
+      if constexpr (has_recover<D, I, decltype(r)>::value) {
+        return I::recover(type<D>, std::move(r));
+      }
+      else {
+        return r;
+      }
+    }
+    if (begin == end) {
+      return detail::failure<I, D>(begin, begin, end);
+    }
+    if constexpr (std::is_convertible_v<
+                      typename result_traits<decltype(r)>::failure_type,
+                      ItB>) {
+      report_error(static_cast<ItB>(r.error()), expected);
+    }
+    else {
+      report_error(begin, expected);
+    }
+    auto it = begin;
+    for (; it != end; ++it) {
+      auto s = synchronization(it, end);
+      if (has_value(s) && next_iterator(s) != begin) {
+        return detail::success<I, D>(begin, next_iterator(std::move(s)), end);
+      }
+    }
+    return detail::success<I, D>(begin, it, end);
+  }
+};
+
+template <class R, class I>
+struct rule_parser {
+  R reference;
+  template <class ItB, class ItE>
+  auto operator()(ItB begin, ItE end) const {
+    return reference.get().template parse<I>(begin, end);
+  }
+};
+
+template <class D,
+          class I,
+          class = std::make_index_sequence<std::decay_t<D>::sequence_length>>
+struct interpreted_sequence;
+template <class D, class I, std::size_t... Is>
+struct interpreted_sequence<D, I, std::index_sequence<Is...>> {
+  using type = std::tuple<decltype(std::declval<const I&>()(
+      std::declval<const D&>().template parser<Is>()))...>;
+};
+template <class D, class I>
+using interpreted_sequence_t = typename interpreted_sequence<D, I>::type;
+
+template <class D, class I, std::size_t... Is>
+[[nodiscard]] constexpr interpreted_sequence_t<D, I> interpret_sequence(
+    const D& descriptor,
+    const I& interpreter,
+    [[maybe_unused]] std::index_sequence<Is...>) noexcept {
+  return interpreted_sequence_t<D, I>{
+      interpreter(descriptor.template parser<Is>())...};
+}
+
+template <class D, class I>
+[[nodiscard]] constexpr interpreted_sequence_t<D, I> interpret_sequence(
+    const D& descriptor,
+    const I& interpreter) noexcept {
+  return interpret_sequence(
+      descriptor,
+      interpreter,
+      std::make_index_sequence<std::decay_t<D>::sequence_length>{});
+}
+
+template <std::size_t S,
+          class D,
+          class I,
+          class Ps,
+          class ItB,
+          class ItE,
+          class... Args>
 constexpr detail::result_t<I, ItB, D> call_sequence(
-    [[maybe_unused]] D&& descriptor,
-    I&& interpreter,
+    [[maybe_unused]] const Ps& parsers,
     [[maybe_unused]] ItB beg,
     [[maybe_unused]] ItB cur,
     [[maybe_unused]] ItE end,
     Args&&... args) noexcept {
-  if constexpr (S < std::decay_t<D>::sequence_length) {
-    auto r = std::forward<I>(interpreter)(
-        std::forward<D>(descriptor).template parser<S>())(cur, end);
+  if constexpr (S < std::tuple_size_v<Ps>) {
+    auto r = std::get<S>(parsers)(cur, end);
     if (has_value(r)) {
-      return call_sequence<S + 1>(std::forward<D>(descriptor),
-                                  std::forward<I>(interpreter),
-                                  beg,
-                                  next_iterator(r),
-                                  end,
-                                  std::forward<Args>(args)...,
-                                  std::move(r));
+      return call_sequence<S + 1, D, I>(parsers,
+                                        beg,
+                                        next_iterator(r),
+                                        end,
+                                        std::forward<Args>(args)...,
+                                        std::move(r));
     }
     return detail::failure<I, D>(beg, cur, end);
   }
@@ -162,31 +641,36 @@ constexpr detail::result_t<I, ItB, D> call_sequence(
 
 template <class S, class I>
 struct sequence_parser {
-  S descriptor;
-  I interpreter;
+  interpreted_sequence_t<S, I> parsers;
 
   template <class T, class U>
   constexpr auto operator()(T beg, U e) const noexcept
       -> detail::result_t<I, T, S> {
-    return detail::call_sequence<0>(
-        std::move(descriptor), std::move(interpreter), beg, beg, e);
+    return detail::call_sequence<0, S, I>(parsers, beg, beg, e);
   }
 };
 
-template <std::size_t S, class D, class I, class ItB, class ItE>
+template <std::size_t S, class D>
+using branch_t = detail::remove_cvref_t<
+    decltype(std::declval<const D&>().template parser<S>())>;
+
+template <std::size_t S, class D, class I, class Ps, class ItB, class ItE>
 constexpr detail::result_t<I, ItB, D> call_alternative(
-    [[maybe_unused]] D&& descriptor,
-    I&& interpreter,
+    [[maybe_unused]] const Ps& parsers,
     [[maybe_unused]] ItB beg,
     [[maybe_unused]] ItE end) noexcept {
-  if constexpr (S < std::decay_t<D>::sequence_length) {
-    auto r = std::forward<I>(interpreter)(
-        std::forward<D>(descriptor).template parser<S>())(beg, end);
+  if constexpr (S < std::tuple_size_v<Ps>) {
+    constexpr bool may_commit = description::may_commit_v<branch_t<S, D>>;
+    detail::choice_branch<may_commit> branch;
+    auto r = std::get<S>(parsers)(beg, end);
+    const bool committed = branch.leave();
     if (has_value(r)) {
       return detail::alternative<I, D, S>(std::move(r));
     }
-    return call_alternative<S + 1>(
-        std::forward<D>(descriptor), std::forward<I>(interpreter), beg, end);
+    if (committed) {
+      return detail::failure<I, D>(beg, beg, end);
+    }
+    return call_alternative<S + 1, D, I>(parsers, beg, end);
   }
   else {
     return detail::failure<I, D>(beg, beg, end);
@@ -195,14 +679,12 @@ constexpr detail::result_t<I, ItB, D> call_alternative(
 
 template <class A, class I>
 struct alternative_parser {
-  A descriptor;
-  I interpreter;
+  interpreted_sequence_t<A, I> parsers;
 
   template <class T, class U>
   constexpr auto operator()(T beg, U e) const noexcept
       -> detail::result_t<I, T, A> {
-    return detail::call_alternative<0>(
-        std::move(descriptor), std::move(interpreter), beg, e);
+    return detail::call_alternative<0, A, I>(parsers, beg, e);
   }
 };
 
@@ -231,6 +713,56 @@ struct modifier_parser {
   }
 };
 
+template <class D, class I, class P, class A, class B, class = void>
+struct has_lazy : std::false_type {};
+template <class D, class I, class P, class A, class B>
+struct has_lazy<D,
+                I,
+                P,
+                A,
+                B,
+                std::void_t<decltype(I::lazy(type<D>,
+                                             std::declval<const P&>(),
+                                             std::declval<A>(),
+                                             std::declval<B>()))>>
+    : std::true_type {};
+
+// Interpreters without a lazy representation match the elements eagerly, as
+// `many` does, so that they see where the input stops being valid.
+template <class D, class I, class P>
+struct lazy_parser {
+  constexpr static inline bool may_commit =
+      description::may_commit_v<typename D::parser_t>;
+
+  P parser;
+
+  template <class ItB, class ItE>
+  constexpr auto operator()(ItB begin, ItE end) const noexcept
+      -> detail::result_t<I, ItB, D> {
+    if constexpr (has_lazy<D, I, P, ItB, ItE>::value) {
+      static_assert(std::is_convertible_v<ItE, ItB>,
+                    "lazy descriptions consume the rest of the input and need "
+                    "an end iterator of the same type as the begin iterator");
+      return I::lazy(type<D>, parser, begin, end);
+    }
+    else {
+      auto it = begin;
+      while (it != end) {
+        detail::choice_branch<may_commit> branch;
+        auto r = parser(it, end);
+        if (branch.leave() && !has_value(r)) {
+          return detail::failure<I, D>(begin, it, end);
+        }
+        if (!has_value(r)) {
+          break;
+        }
+        it = next_iterator(std::move(r));
+      }
+      return detail::success<I, D>(begin, it, end);
+    }
+  }
+};
+
 template <class D, class I>
 struct bind_parser {
   D descriptor;
@@ -251,6 +783,117 @@ struct bind_parser {
   }
 };
 
+// Parsers built by a `cached_bind`, indexed by the bound value. Entries are
+// never moved once added, parsers being possibly still running when a nested
+// call of the same bind adds another one.
+template <class V, class P, class = void>
+struct continuation_cache {
+  constexpr static inline std::size_t capacity = 16;
+
+  continuation_cache() { entries.reserve(capacity); }
+
+  std::vector<std::pair<V, P>> entries;
+
+  // Values past the capacity get a parser of their own at each call.
+  template <class F, class G>
+  auto apply(const V& value, F&& make, G&& use) {
+    for (const auto& entry : entries) {
+      if (entry.first == value) {
+        return use(entry.second);
+      }
+    }
+    if (entries.size() == capacity) {
+      return use(std::forward<F>(make)());
+    }
+    entries.emplace_back(value, std::forward<F>(make)());
+    return use(entries.back().second);
+  }
+};
+
+template <class V, class P>
+struct continuation_cache<
+    V,
+    P,
+    std::enable_if_t<std::is_integral_v<V> && sizeof(V) == 1>> {
+  std::array<std::optional<P>, 256> entries;
+
+  template <class F, class G>
+  auto apply(V value, F&& make, G&& use) {
+    auto& entry = entries[static_cast<unsigned char>(value)];
+    if (!entry) {
+      entry.emplace(std::forward<F>(make)());
+    }
+    return use(*entry);
+  }
+};
+
+// The caches of a `cached_bind_parser`, one per type of bound value and
+// continuation. A cache is never replaced nor moved once allocated, as a
+// nested call may add another one while it is in use. Copies of the parser
+// start with no cache, so that each copy can be handed to its own thread.
+struct continuation_caches {
+  continuation_caches() noexcept = default;
+  continuation_caches([[maybe_unused]] const continuation_caches&) noexcept {}
+  continuation_caches(continuation_caches&&) noexcept = default;
+  continuation_caches& operator=(
+      [[maybe_unused]] const continuation_caches&) noexcept {
+    entries.clear();
+    return *this;
+  }
+  continuation_caches& operator=(continuation_caches&&) noexcept = default;
+  ~continuation_caches() noexcept = default;
+
+  template <class C>
+  C& get() {
+    for (const auto& [key, cache] : entries) {
+      if (key == &type_key<C>::id) {
+        return *static_cast<C*>(cache.get());
+      }
+    }
+    entries.emplace_back(&type_key<C>::id, std::make_shared<C>());
+    return *static_cast<C*>(entries.back().second.get());
+  }
+
+  std::vector<std::pair<const void*, std::shared_ptr<void>>> entries;
+};
+
+// The caches are allocated on the first call, and updated without any
+// synchronization: the parser can't be shared between threads.
+template <class D, class I>
+struct cached_bind_parser {
+  D descriptor;
+  I interpreter;
+  mutable continuation_caches caches;
+
+  template <class A, class B>
+  using ret = typename D::template final_parser_type<A, B>;
+
+  template <class ItB, class ItE>
+  auto operator()(ItB begin, ItE end) const
+      -> detail::result_t<I, ItB, ret<ItB, ItE>> {
+    auto r = descriptor.interpret()(begin, end);
+    if (has_value(r)) {
+      const auto& bound = value(r);
+      using bound_t = remove_cvref_t<decltype(bound)>;
+      if constexpr (!description::is_cacheable_value_v<bound_t>) {
+        // The value may refer to the input, which the cache would outlive.
+        auto nparser = interpreter(descriptor(bound));
+        return nparser(next_iterator(r), end);
+      }
+      else {
+        const auto make = [&] { return interpreter(descriptor(bound)); };
+        using cache_t =
+            continuation_cache<bound_t, remove_cvref_t<decltype(make())>>;
+        return caches.get<cache_t>().apply(
+            bound, make, [&](const auto& nparser) {
+              return nparser(next_iterator(r), end);
+            });
+      }
+    }
+    return detail::failure<I, ret<ItB, ItE>>(begin, begin, end);
+  }
+};
+
 }  // namespace detail
 
 template <class T,
@@ -263,6 +906,16 @@ constexpr auto parsers_interpreters_make_parser(T&& pred,
       std::forward<T>(pred)};
 }
 
+template <class R,
+          class I,
+          std::enable_if_t<description::is_rule_reference_v<R>, int> = 0>
+constexpr auto parsers_interpreters_make_parser(R&& reference,
+                                                [[maybe_unused]] I&&) {
+  return detail::rule_parser<detail::remove_cvref_t<R>,
+                             detail::remove_cvref_t<I>>{
+      std::forward<R>(reference)};
+}
+
 template <class T,
           class I,
           std::enable_if_t<description::is_guard_v<T>, int> = 0>
@@ -285,6 +938,82 @@ constexpr auto parsers_interpreters_make_parser(M&& descriptor,
       descriptor.count(), interpreter(std::forward<M>(descriptor).parser())};
 }
 
+template <
+    class M,
+    class I,
+    std::enable_if_t<description::is_bounded_range_v<std::decay_t<M>>, int> =
+        0>
+constexpr auto parsers_interpreters_make_parser(M&& descriptor,
+                                                I&& interpreter) noexcept {
+  return detail::bounded_range_parser<
+      detail::remove_cvref_t<M>,
+      detail::remove_cvref_t<I>,
+      decltype(interpreter(std::forward<M>(descriptor).parser()))>{
+      static_cast<const typename detail::remove_cvref_t<M>::bounds_t&>(
+          descriptor),
+      interpreter(std::forward<M>(descriptor).parser())};
+}
+
+template <
+    class M,
+    class I,
+    std::enable_if_t<description::is_separated_v<std::decay_t<M>>, int> = 0>
+constexpr auto parsers_interpreters_make_parser(M&& descriptor,
+                                                I&& interpreter) noexcept {
+  using separator_t = description::discard<
+      typename detail::remove_cvref_t<M>::separator_t>;
+  return detail::separated_parser<
+      detail::remove_cvref_t<M>,
+      detail::remove_cvref_t<I>,
+      decltype(interpreter(std::forward<M>(descriptor).parser())),
+      decltype(interpreter(std::declval<separator_t>()))>{
+      interpreter(descriptor.parser()),
+      interpreter(separator_t{descriptor.separator()})};
+}
+
+template <
+    class C,
+    class I,
+    std::enable_if_t<description::is_commit_v<std::decay_t<C>>, int> = 0>
+constexpr auto parsers_interpreters_make_parser(C&& descriptor,
+                                                I&& interpreter) noexcept {
+  return detail::commit_parser<
+      detail::remove_cvref_t<C>,
+      detail::remove_cvref_t<I>,
+      decltype(interpreter(std::forward<C>(descriptor).parser()))>{
+      interpreter(std::forward<C>(descriptor).parser())};
+}
+
+template <
+    class R,
+    class I,
+    std::enable_if_t<description::is_recover_v<std::decay_t<R>>, int> = 0>
+constexpr auto parsers_interpreters_make_parser(R&& descriptor,
+                                                I&& interpreter) noexcept {
+  using synchronization_t = description::discard<
+      typename detail::remove_cvref_t<R>::synchronization_t>;
+  return detail::recover_parser<
+      detail::remove_cvref_t<R>,
+      detail::remove_cvref_t<I>,
+      decltype(interpreter(std::forward<R>(descriptor).parser())),
+      decltype(interpreter(std::declval<synchronization_t>()))>{
+      interpreter(descriptor.parser()),
+      interpreter(synchronization_t{descriptor.synchronization()}),
+      descriptor.expected()};
+}
+
+template <class L,
+          class I,
+          std::enable_if_t<description::is_lazy_v<std::decay_t<L>>, int> = 0>
+constexpr auto parsers_interpreters_make_parser(L&& descriptor,
+                                                I&& interpreter) noexcept {
+  return detail::lazy_parser<
+      detail::remove_cvref_t<L>,
+      detail::remove_cvref_t<I>,
+      decltype(interpreter(std::forward<L>(descriptor).parser()))>{
+      interpreter(std::forward<L>(descriptor).parser())};
+}
+
 template <class R,
           class I,
           std::enable_if_t<description::is_recursive_v<R>, int> = 0>
@@ -302,7 +1031,7 @@ constexpr auto parsers_interpreters_make_parser(
     S&& descriptor,
     [[maybe_unused]] I&& interpreter) noexcept {
   return detail::sequence_parser<detail::remove_cvref_t<S>, std::decay_t<I>>{
-      std::forward<S>(descriptor), std::forward<I>(interpreter)};
+      detail::interpret_sequence(descriptor, interpreter)};
 }
 
 template <class A,
@@ -312,7 +1041,7 @@ constexpr auto parsers_interpreters_make_parser(
     A&& descriptor,
     [[maybe_unused]] I&& interpreter) noexcept {
   return detail::alternative_parser<detail::remove_cvref_t<A>, std::decay_t<I>>{
-      std::forward<A>(descriptor), std::forward<I>(interpreter)};
+      detail::interpret_sequence(descriptor, interpreter)};
 }
 
 template <
@@ -330,9 +1059,16 @@ template <class D,
           std::enable_if_t<description::is_bind_v<std::decay_t<D>>, int> = 0>
 constexpr auto parsers_interpreters_make_parser(D&& descriptor,
                                                 I&& interpreter) noexcept {
-  return detail::bind_parser<detail::remove_cvref_t<D>,
-                             detail::remove_cvref_t<I>>{
-      std::forward<D>(descriptor), std::forward<I>(interpreter)};
+  if constexpr (description::is_cached_bind_v<detail::remove_cvref_t<D>>) {
+    return detail::cached_bind_parser<detail::remove_cvref_t<D>,
+                                      detail::remove_cvref_t<I>>{
+        std::forward<D>(descriptor), std::forward<I>(interpreter)};
+  }
+  else {
+    return detail::bind_parser<detail::remove_cvref_t<D>,
+                               detail::remove_cvref_t<I>>{
+        std::forward<D>(descriptor), std::forward<I>(interpreter)};
+  }
 }
 
 }  // namespace parsers::customization_points
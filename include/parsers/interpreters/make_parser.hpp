@@ -2,11 +2,22 @@
 #define GUARD_PARSER_INTERPRETERS_MAKE_PARSER_HPP
 
 #include "./customization_points.hpp"
+#include "../optimize.hpp"
+#include "../regular.hpp"
 
 namespace parsers::interpreters {
 
 namespace detail {
 using ::parsers::customization_points::parsers_interpreters_make_parser;
+using ::parsers::detail::remove_cvref_t;
+
+// Interpreters defining a true `instruments` member get to wrap every parser
+// built for them through `instrument(type<Description>, build)`.
+template <class T, class = void>
+struct instruments : std::false_type {};
+template <class T>
+struct instruments<T, std::void_t<decltype(T::instruments)>>
+    : std::bool_constant<T::instruments> {};
 
 template <class Traits>
 struct make_parser_t : Traits {
@@ -20,7 +31,30 @@ struct make_parser_t : Traits {
 
   template <class T>
   [[nodiscard]] constexpr auto operator()(T&& descriptor) const noexcept {
-    return parsers_interpreters_make_parser(std::forward<T>(descriptor), *this);
+    if constexpr (instruments<Traits>::value) {
+      return this->instrument(::parsers::type<remove_cvref_t<T>>, [&] {
+        return interpret(std::forward<T>(descriptor));
+      });
+    }
+    else {
+      return interpret(std::forward<T>(descriptor));
+    }
+  }
+
+ private:
+  template <class T>
+  [[nodiscard]] constexpr auto interpret(T&& descriptor) const noexcept {
+    using description_t = remove_cvref_t<T>;
+    if constexpr (::parsers::regular::detail::
+                      compiles_to_automaton_v<Traits, description_t>) {
+      return ::parsers::regular::detail::automaton_parser<description_t,
+                                                          make_parser_t>{
+          *this};
+    }
+    else {
+      return parsers_interpreters_make_parser(
+          ::parsers::optimize<Traits>(std::forward<T>(descriptor)), *this);
+    }
   }
 };
 }  // namespace detail
@@ -15,6 +15,9 @@ using namespace ::parsers::detail;
 }  // namespace detail
 
 struct matcher {
+  constexpr static inline bool ignores_structure = true;
+  constexpr static inline bool ignores_failure_position = true;
+
   template <class I, class T = I>
   using result_t = std::optional<std::decay_t<I>>;
 
@@ -1,11 +1,16 @@
 #ifndef GUARD_PARSERS_BASIC_PARSER_HPP
 #define GUARD_PARSERS_BASIC_PARSER_HPP
 
+#include "../allocations.hpp"
 #include "../description.hpp"
+#include "../lazy_range.hpp"
 #include "../range.hpp"
+#include "../repetition_sizes.hpp"
 #include "../result_traits.hpp"
 #include "../utility.hpp"
+#include "./make_parser.hpp"
 
+#include <array>
 #include <memory>
 #include <optional>
 #include <type_traits>
@@ -16,64 +21,86 @@ namespace parsers::interpreters {
 namespace detail {
 using namespace ::parsers::detail;
 
-template <std::size_t S, class... Args>
-struct index_sequence_for_non_empty {
-  using type = typename index_sequence_for_non_empty<0,
-                                                     std::index_sequence<>,
-                                                     Args...>::type;
-};
-
-template <std::size_t S, std::size_t... Ss, class A, class... Args>
-struct index_sequence_for_non_empty<S, std::index_sequence<Ss...>, A, Args...> {
-  using type =
-      typename index_sequence_for_non_empty<S + 1,
-                                            std::index_sequence<Ss..., S>,
-                                            Args...>::type;
-};
-
-template <std::size_t S, std::size_t... Ss, class... Args>
-struct index_sequence_for_non_empty<S,
-                                    std::index_sequence<Ss...>,
-                                    parsers::empty,
-                                    Args...> {
-  using type = typename index_sequence_for_non_empty<S + 1,
-                                                     std::index_sequence<Ss...>,
-                                                     Args...>::type;
+// Positions of the elements of `Args` that are not `parsers::empty`. Computed
+// by a constexpr loop so that a sequence of N elements costs a constant number
+// of instantiations rather than N, each over a pack of up to N types.
+template <class... Args>
+struct non_empty_positions {
+  constexpr static inline bool keep[] = {
+      !std::is_same_v<Args, parsers::empty>..., false};
+  constexpr static inline std::size_t count =
+      (std::size_t{0} + ... +
+       std::size_t{!std::is_same_v<Args, parsers::empty>});
+
+  [[nodiscard]] constexpr static std::array<std::size_t, count>
+  positions() noexcept {
+    std::array<std::size_t, count> result{};
+    std::size_t n = 0;
+    for (std::size_t i = 0; i < sizeof...(Args); ++i) {
+      if (keep[i]) {
+        result[n++] = i;
+      }
+    }
+    return result;
+  }
 };
 
-template <std::size_t S, std::size_t... Ss>
-struct index_sequence_for_non_empty<S, std::index_sequence<Ss...>> {
-  using type = std::index_sequence<Ss...>;
+template <class P, class = std::make_index_sequence<P::count>>
+struct positions_sequence;
+template <class P, std::size_t... Is>
+struct positions_sequence<P, std::index_sequence<Is...>> {
+  constexpr static inline std::array<std::size_t, P::count> values =
+      P::positions();
+  using type = std::index_sequence<values[Is]...>;
 };
 
 template <class... Args>
 using index_sequence_for_non_empty_t =
-    typename index_sequence_for_non_empty<0, Args...>::type;
-
-template <class... Args>
-struct collapse_tuple_arguments;
-template <class A, class... Args, class... Args2>
-struct collapse_tuple_arguments<std::tuple<A, Args...>, std::tuple<Args2...>> {
-  using type = typename collapse_tuple_arguments<std::tuple<Args...>,
-                                                 std::tuple<Args2..., A>>::type;
-};
-template <class... Args, class... Args2>
-struct collapse_tuple_arguments<std::tuple<parsers::empty, Args...>,
-                                std::tuple<Args2...>> {
-  using type = typename collapse_tuple_arguments<std::tuple<Args...>,
-                                                 std::tuple<Args2...>>::type;
+    typename positions_sequence<non_empty_positions<Args...>>::type;
+
+// Random access into a pack through overload resolution against its indexed
+// bases, instead of peeling one element per instantiation. The call is
+// qualified: argument-dependent lookup would complete the elements of the
+// pack, among which the pointers to recursive descriptions being defined.
+template <std::size_t I, class T>
+struct indexed_type {
+  using type = T;
 };
-template <>
-struct collapse_tuple_arguments<std::tuple<>, std::tuple<>> {
+template <class Is, class... Ts>
+struct indexed_types;
+template <std::size_t... Is, class... Ts>
+struct indexed_types<std::index_sequence<Is...>, Ts...>
+    : indexed_type<Is, Ts>... {};
+
+template <std::size_t I, class T>
+indexed_type<I, T> select_type(const indexed_type<I, T>&) noexcept;
+
+template <std::size_t I, class... Ts>
+using nth_type_t = typename decltype(detail::select_type<I>(
+    std::declval<
+        const indexed_types<std::index_sequence_for<Ts...>, Ts...>&>()))::type;
+
+template <class Is, class... Args>
+struct collapse_selected {
   using type = parsers::empty;
 };
-template <class A>
-struct collapse_tuple_arguments<std::tuple<>, std::tuple<A>> {
-  using type = A;
+template <std::size_t I, class... Args>
+struct collapse_selected<std::index_sequence<I>, Args...> {
+  using type = nth_type_t<I, Args...>;
 };
-template <class A, class B, class... Args>
-struct collapse_tuple_arguments<std::tuple<>, std::tuple<A, B, Args...>> {
-  using type = std::tuple<A, B, Args...>;
+template <std::size_t I, std::size_t J, std::size_t... Is, class... Args>
+struct collapse_selected<std::index_sequence<I, J, Is...>, Args...> {
+  using type = std::tuple<nth_type_t<I, Args...>,
+                          nth_type_t<J, Args...>,
+                          nth_type_t<Is, Args...>...>;
+};
+
+// The result of a sequence: nothing, the single non-empty element, or a
+// tuple of the non-empty elements.
+template <class... Args>
+struct collapse_tuple_arguments {
+  using type = typename collapse_selected<index_sequence_for_non_empty_t<Args...>,
+                                          Args...>::type;
 };
 
 template <class T, class P, class I>
@@ -90,6 +117,7 @@ struct unique_ptr : std::unique_ptr<recursive_pointer_type<T, P, I>> {
                 std::forward<U>(u))} {
     static_assert(
         std::is_same_v<std::decay_t<U>, recursive_pointer_type<T, P, I>>);
+    count_allocation(sizeof(recursive_pointer_type<T, P, I>));
   }
 
   unique_ptr(unique_ptr&& ptr) noexcept = default;
@@ -145,6 +173,16 @@ constexpr static inline empty build([[maybe_unused]] type_t<T>,
   return {};
 }
 
+// The initial value of a folded list.
+template <class T,
+          class I,
+          std::enable_if_t<description::folds_v<T>, int> = 0>
+constexpr static inline auto build([[maybe_unused]] type_t<T>,
+                                   [[maybe_unused]] I&& b,
+                                   [[maybe_unused]] I&& e) noexcept {
+  return typename T::fold_t{}();
+}
+
 template <class T, class I>
 struct object {
   using type = decltype(build(type<T>, std::declval<I>(), std::declval<I>()));
@@ -182,11 +220,38 @@ struct object_parser {
   struct object<R, I, std::enable_if_t<description::is_recursive_v<R>>> {
     using type = detail::unique_ptr<R, object_parser, I>;
   };
+  template <class R, class I>
+  struct object<R, I, std::enable_if_t<description::is_rule_reference_v<R>>> {
+    using type = typename R::result_type;
+  };
   template <class M, class I>
   struct object<M, I, std::enable_if_t<description::is_dynamic_range_v<M>>> {
     using type = std::vector<object_t<I, typename M::parser_t>>;
   };
   template <class M, class I>
+  struct object<M, I, std::enable_if_t<description::is_bounded_range_v<M>>> {
+    using type = std::vector<object_t<I, typename M::parser_t>>;
+  };
+  template <class M, class I>
+  struct object<M, I, std::enable_if_t<description::is_separated_v<M>>> {
+    template <class F, class = void>
+    struct v {
+      using type = std::vector<object_t<I, typename M::parser_t>>;
+    };
+    template <class F>
+    struct v<F, std::enable_if_t<!std::is_void_v<F>>> {
+      using type = decltype(F{}());
+    };
+    using type = typename v<typename M::fold_t>::type;
+  };
+  template <class L, class I>
+  struct object<L, I, std::enable_if_t<description::is_lazy_v<L>>> {
+    using type = parsers::lazy_range<
+        decltype(std::declval<const make_parser_t<object_parser>&>()(
+            std::declval<typename L::parser_t>())),
+        I>;
+  };
+  template <class M, class I>
   struct object<M, I, std::enable_if_t<description::is_bind_v<M>>> {
     using type = object_t<I, typename M::template final_parser_type<I, I>>;
   };
@@ -196,10 +261,10 @@ struct object_parser {
     struct t;
     template <template <class...> class C, class... Ts>
     struct t<C<Ts...>> {
-      using type = std::tuple<object_t<I, Ts>...>;
+      using type =
+          typename detail::collapse_tuple_arguments<object_t<I, Ts>...>::type;
     };
-    using type = typename detail::collapse_tuple_arguments<typename t<T>::type,
-                                                           std::tuple<>>::type;
+    using type = typename t<T>::type;
   };
   template <class T, class I>
   struct object<T, I, std::enable_if_t<description::is_alternative_v<T>>> {
@@ -216,6 +281,14 @@ struct object_parser {
   struct object<M, I, std::enable_if_t<description::is_modifier_v<M>>> {
     using type = typename M::template result_t<I>;
   };
+  template <class C, class I>
+  struct object<C, I, std::enable_if_t<description::is_commit_v<C>>> {
+    using type = object_t<I, typename C::parser_t>;
+  };
+  template <class R, class I>
+  struct object<R, I, std::enable_if_t<description::is_recover_v<R>>> {
+    using type = std::optional<object_t<I, typename R::parser_t>>;
+  };
 
   template <class I, class T>
   using success_t = std::pair<I, object_t<I, T>>;
@@ -252,11 +325,80 @@ struct object_parser {
                                        Acc& acc,
                                        Add&& add) noexcept {
     if (add.has_value()) {
-      acc.value().second.push_back(std::get<1>(std::forward<Add>(add).value()));
-      acc.value().first = std::get<0>(std::forward<Add>(add).value());
+      if constexpr (description::folds_v<M>) {
+        acc->second = typename M::fold_t{}(std::move(acc->second),
+                                           std::get<1>(*std::forward<Add>(add)));
+      }
+      else {
+        auto& values = acc->second;
+        const auto capacity = values.capacity();
+        values.push_back(std::get<1>(*std::forward<Add>(add)));
+        if (values.capacity() != capacity) {
+          detail::count_allocation(values.capacity() *
+                                   sizeof(typename std::decay_t<
+                                          decltype(values)>::value_type));
+        }
+      }
+      acc->first = std::get<0>(*std::forward<Add>(add));
     }
     return std::forward<Add>(add);
   }
+
+  // With sizes recorded by a first pass (see `parse_two_phase`), the vector
+  // of a repetition is allocated once at its final size.
+  template <class M, class Acc>
+  constexpr static inline std::size_t begin_repetition(
+      [[maybe_unused]] type_t<M>,
+      Acc& acc) {
+    auto* sizes = detail::active_repetition_sizes();
+    if (sizes == nullptr) {
+      return 0;
+    }
+    const auto n = sizes->begin();
+    if constexpr (!description::folds_v<M>) {
+      if (sizes->current_mode() == repetition_sizes::mode::replay && n > 0) {
+        auto& values = acc->second;
+        values.reserve(n);
+        detail::count_allocation(
+            values.capacity() *
+            sizeof(typename std::decay_t<decltype(values)>::value_type));
+      }
+    }
+    return n;
+  }
+
+  template <class M, class R, class It>
+  constexpr static inline R extend([[maybe_unused]] type_t<M>,
+                                   R&& result,
+                                   It position) noexcept {
+    result->first = position;
+    return std::move(result);
+  }
+
+  // Repetitions with bounds reserve their elements once, unless the sizes of
+  // a first pass did already.
+  template <class M, class Acc>
+  constexpr static inline void reserve_repetition([[maybe_unused]] type_t<M>,
+                                                  Acc& acc,
+                                                  std::size_t n) {
+    auto& values = acc->second;
+    if (n > 0 && values.capacity() == 0) {
+      values.reserve(n);
+      detail::count_allocation(
+          values.capacity() *
+          sizeof(typename std::decay_t<decltype(values)>::value_type));
+    }
+  }
+
+  template <class M>
+  constexpr static inline void end_repetition([[maybe_unused]] type_t<M>,
+                                              std::size_t slot,
+                                              std::size_t count) noexcept {
+    if (auto* sizes = detail::active_repetition_sizes()) {
+      sizes->end(slot, count);
+    }
+  }
+
   template <class R, class... Args>
   constexpr static inline auto build_sequence_result(
       [[maybe_unused]] std::index_sequence<>,
@@ -284,7 +426,7 @@ struct object_parser {
   template <class S, class... Args>
   constexpr static inline auto sequence([[maybe_unused]] type_t<S>,
                                         Args&&... args) noexcept {
-    const auto last_iterator = std::get<0>(detail::last_of(args...).value());
+    const auto last_iterator = std::get<0>(*detail::last_of(args...));
     using result_type =
         object_t<decltype(detail::last_of(args...).value().first), S>;
     using index_sequence = detail::index_sequence_for_non_empty_t<
@@ -293,16 +435,35 @@ struct object_parser {
         std::move(last_iterator),
         object_parser::build_sequence_result<result_type>(
             index_sequence{},
-            std::tuple{std::get<1>(std::forward<Args>(args).value())...}));
+            std::tuple{std::get<1>(*std::forward<Args>(args))...}));
   }
 
   template <std::size_t S, class D, class T>
   constexpr static inline auto alternative([[maybe_unused]] type_t<D>,
                                            T&& t) noexcept {
     return dpsg::success(
-        std::get<0>(std::forward<T>(t).value()),
+        std::get<0>(*std::forward<T>(t)),
         object_t<decltype(t.value().first), D>{
-            std::in_place_index<S>, std::get<1>(std::forward<T>(t).value())});
+            std::in_place_index<S>, std::get<1>(*std::forward<T>(t))});
+  }
+
+  // Inputs skipped by `recover` are left empty.
+  template <class D, class T>
+  constexpr static inline auto recover([[maybe_unused]] type_t<D>,
+                                       T&& t) noexcept {
+    return dpsg::success(
+        std::get<0>(*std::forward<T>(t)),
+        object_t<decltype(t.value().first), D>{
+            std::in_place, std::get<1>(*std::forward<T>(t))});
+  }
+
+  template <class D, class P, class IB, class IE>
+  constexpr static inline result_t<IB, D> lazy([[maybe_unused]] type_t<D>,
+                                                const P& parser,
+                                                IB begin,
+                                                IE end) noexcept {
+    return dpsg::success(static_cast<IB>(end),
+                         object_t<IB, D>{parser, begin, static_cast<IB>(end)});
   }
 
   template <class M, class IB, class IE, class T, class D = std::decay_t<M>>
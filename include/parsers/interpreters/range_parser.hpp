@@ -15,6 +15,8 @@ using namespace ::parsers::detail;
 }  // namespace detail
 
 struct range_parser {
+  constexpr static inline bool ignores_structure = true;
+
   template <class I, class T = I>
   using result_t = dpsg::result<std::pair<std::decay_t<I>, std::decay_t<I>>,
                                 std::decay_t<I>>;
@@ -40,7 +42,7 @@ struct range_parser {
                                        Acc& acc,
                                        Add&& add) noexcept {
     if (add.has_value()) {
-      acc.value().second = std::get<1>(std::forward<Add>(add).value());
+      acc->second = std::get<1>(*std::forward<Add>(add));
     }
     return std::forward<Add>(add);
   }
@@ -50,8 +52,8 @@ struct range_parser {
                                         A&& a,
                                         Args&&... args) noexcept {
     return dpsg::success(
-        std::get<0>(std::forward<A>(a).value()),
-        std::get<1>(detail::last_of(std::forward<Args>(args)...).value()));
+        std::get<0>(*std::forward<A>(a)),
+        std::get<1>(*detail::last_of(std::forward<Args>(args)...)));
   }
 
   template <std::size_t S, class D, class I>
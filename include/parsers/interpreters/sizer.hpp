@@ -0,0 +1,73 @@
+#ifndef GUARD_PARSERS_INTERPRETERS_SIZER_HPP
+#define GUARD_PARSERS_INTERPRETERS_SIZER_HPP
+
+#include "../repetition_sizes.hpp"
+#include "../result_traits.hpp"
+#include "../utility.hpp"
+#include "./make_parser.hpp"
+#include "./object_parser.hpp"
+#include "./range_parser.hpp"
+
+#include <type_traits>
+#include <utility>
+
+namespace parsers::interpreters {
+
+// Validates an input like `range_parser` while recording the size of each
+// repetition in the current `repetition_sizes`. It keeps the structure of the
+// description so that it meets the repetitions in the same order as
+// `object_parser` does.
+struct sizer : range_parser {
+  constexpr static inline bool ignores_structure = false;
+
+  template <class M, class Acc>
+  static std::size_t begin_repetition([[maybe_unused]] type_t<M>,
+                                      [[maybe_unused]] Acc& acc) {
+    auto* sizes = detail::current_repetition_sizes();
+    return sizes != nullptr ? sizes->begin() : 0;
+  }
+
+  template <class M>
+  static void end_repetition([[maybe_unused]] type_t<M>,
+                             std::size_t slot,
+                             std::size_t count) noexcept {
+    if (auto* sizes = detail::current_repetition_sizes()) {
+      sizes->end(slot, count);
+    }
+  }
+
+  // Descriptions built by the object parser are sized as well, the others
+  // (`as_range`, `discard`...) are run as `object_parser` would run them.
+  template <class I,
+            class D,
+            class ItB,
+            class ItE,
+            class D1 = detail::remove_cvref_t<D>>
+  static auto modify([[maybe_unused]] type_t<D1>,
+                     I&& interpreter,
+                     D&& description,
+                     ItB begin,
+                     ItE end) -> result_t<ItB> {
+    auto result = [&] {
+      if constexpr (std::is_same_v<
+                        detail::remove_cvref_t<decltype(
+                            description.interpreter())>,
+                        make_parser_t<object_parser>>) {
+        return interpreter(description.inner_parser())(begin, end);
+      }
+      else {
+        return description.interpreter()(description.inner_parser())(begin,
+                                                                      end);
+      }
+    }();
+    using traits = parsers::result_traits<decltype(result)>;
+    if (!traits::has_value(result)) {
+      return dpsg::failure(begin);
+    }
+    return dpsg::success(begin, traits::next_iterator(std::move(result)));
+  }
+};
+
+}  // namespace parsers::interpreters
+
+#endif  // GUARD_PARSERS_INTERPRETERS_SIZER_HPP
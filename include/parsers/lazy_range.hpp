@@ -0,0 +1,121 @@
+#ifndef GUARD_PARSERS_LAZY_RANGE_HPP
+#define GUARD_PARSERS_LAZY_RANGE_HPP
+
+#include "./result_traits.hpp"
+
+#include <cstddef>
+#include <iterator>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace parsers {
+
+// The results of a `lazy_many`, parsed as the iteration goes. The parser
+// consumes the rest of the input whether its elements parse or not: once the
+// iteration stops, the iterator tells where and whether an element failed.
+// Iterators refer to the parser held by the range, which must therefore
+// neither be moved nor destroyed while they are in use.
+template <class Parser, class It>
+struct lazy_range {
+  using parser_t = Parser;
+  using input_iterator = It;
+  using result_type = std::invoke_result_t<const parser_t&, It, It>;
+  using value_type = typename result_traits<result_type>::value_type;
+
+  struct iterator {
+    using value_type = typename lazy_range::value_type;
+    using reference = const value_type&;
+    using pointer = const value_type*;
+    using difference_type = std::ptrdiff_t;
+    using iterator_category = std::forward_iterator_tag;
+
+    constexpr iterator() noexcept = default;
+    constexpr iterator(const parser_t& parser, It beg, It end)
+        : _parser{&parser}, _position{beg}, _next{beg}, _end{end} {
+      _parse();
+    }
+
+    [[nodiscard]] constexpr reference operator*() const noexcept {
+      return *_current;
+    }
+    [[nodiscard]] constexpr pointer operator->() const noexcept {
+      return &*_current;
+    }
+
+    constexpr iterator& operator++() {
+      _position = _next;
+      _parse();
+      return *this;
+    }
+    constexpr iterator operator++(int) {
+      auto it = *this;
+      ++*this;
+      return it;
+    }
+
+    [[nodiscard]] constexpr It base() const noexcept { return _next; }
+
+    // Whether the iteration stopped on an element that failed to parse (or
+    // consumed nothing) rather than at the end of the input.
+    [[nodiscard]] constexpr bool failed() const noexcept {
+      return _parser != nullptr && !_current.has_value() && _position != _end;
+    }
+
+    [[nodiscard]] friend constexpr bool operator==(
+        const iterator& left,
+        const iterator& right) noexcept {
+      if (left._current.has_value() != right._current.has_value()) {
+        return false;
+      }
+      return !left._current.has_value() || left._position == right._position;
+    }
+    [[nodiscard]] friend constexpr bool operator!=(
+        const iterator& left,
+        const iterator& right) noexcept {
+      return !(left == right);
+    }
+
+   private:
+    constexpr void _parse() {
+      _current.reset();
+      if (_parser == nullptr || _position == _end) {
+        return;
+      }
+      auto r = (*_parser)(_position, _end);
+      if (!parsers::has_value(r)) {
+        return;
+      }
+      auto next = parsers::next_iterator(r);
+      if (next == _position) {
+        return;
+      }
+      _next = next;
+      _current.emplace(parsers::value(std::move(r)));
+    }
+
+    const parser_t* _parser = nullptr;
+    std::optional<value_type> _current;
+    It _position{};
+    It _next{};
+    It _end{};
+  };
+
+  template <class P>
+  constexpr lazy_range(P&& parser, It beg, It end) noexcept
+      : _parser{std::forward<P>(parser)}, _begin{beg}, _end{end} {}
+
+  [[nodiscard]] constexpr iterator begin() const {
+    return iterator{_parser, _begin, _end};
+  }
+  [[nodiscard]] constexpr iterator end() const noexcept { return iterator{}; }
+
+ private:
+  parser_t _parser;
+  It _begin;
+  It _end;
+};
+
+}  // namespace parsers
+
+#endif  // GUARD_PARSERS_LAZY_RANGE_HPP
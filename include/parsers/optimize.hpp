@@ -0,0 +1,315 @@
+#ifndef GUARD_PARSERS_OPTIMIZE_HPP
+#define GUARD_PARSERS_OPTIMIZE_HPP
+
+#include "./description/alternative.hpp"
+#include "./description/commit.hpp"
+#include "./description/guard.hpp"
+#include "./description/satisfy.hpp"
+#include "./description/sequence.hpp"
+#include "./description/static_string.hpp"
+#include "./utility.hpp"
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace parsers {
+namespace description {
+template <class T>
+struct discard;
+}  // namespace description
+
+namespace detail {
+template <class I, class = void>
+struct ignores_structure : std::false_type {};
+template <class I>
+struct ignores_structure<I,
+                         std::enable_if_t<std::decay_t<I>::ignores_structure>>
+    : std::true_type {};
+
+template <class I, class = void>
+struct ignores_failure_position : std::false_type {};
+template <class I>
+struct ignores_failure_position<
+    I,
+    std::enable_if_t<std::decay_t<I>::ignores_failure_position>>
+    : std::true_type {};
+
+// Flattening and merging elements moves the position at which a sequence
+// reports a failure, so it is reserved to the interpreters that ignore both
+// the shape of the results and where parsing failed.
+template <class I>
+constexpr static inline bool rewrites_freely_v =
+    ignores_structure<I>::value && ignores_failure_position<I>::value;
+
+template <class T>
+constexpr static inline bool is_plain_sequence_v =
+    dpsg::is_template_instance_v<T, description::sequence> ||
+    dpsg::is_template_instance_v<T, description::both>;
+
+template <class T>
+constexpr static inline bool is_plain_alternative_v =
+    dpsg::is_template_instance_v<T, description::alternative> ||
+    dpsg::is_template_instance_v<T, description::either>;
+
+template <class T>
+constexpr static inline bool is_discard_v =
+    dpsg::is_template_instance_v<T, description::discard>;
+
+template <class T>
+struct is_static_character : std::false_type {};
+template <auto C, class T>
+struct is_static_character<description::character<C, T>>
+    : std::is_integral<T> {};
+template <class T>
+constexpr static inline bool is_static_character_v =
+    is_static_character<T>::value;
+
+template <class T>
+struct has_array_element : std::is_array<T> {};
+template <class... Ts>
+struct has_array_element<description::sequence<Ts...>>
+    : std::disjunction<has_array_element<Ts>...> {};
+template <class A, class B>
+struct has_array_element<description::both<A, B>>
+    : std::disjunction<has_array_element<A>, has_array_element<B>> {};
+template <class... Ts>
+struct has_array_element<description::alternative<Ts...>>
+    : std::disjunction<has_array_element<Ts>...> {};
+template <class A, class B>
+struct has_array_element<description::either<A, B>>
+    : std::disjunction<has_array_element<A>, has_array_element<B>> {};
+template <class T>
+struct has_array_element<description::discard<T>> : has_array_element<T> {};
+
+template <class I, class T, class = void>
+struct rewrites
+    : std::bool_constant<!has_array_element<T>::value &&
+                         (rewrites_freely_v<I>
+                              ? (is_discard_v<T> || is_plain_sequence_v<T> ||
+                                 is_plain_alternative_v<T>)
+                              : ignores_structure<I>::value &&
+                                    is_plain_alternative_v<T>)> {};
+template <class I, class T>
+struct rewrites<
+    I,
+    T,
+    std::enable_if_t<!ignores_structure<I>::value && is_discard_v<T>>>
+    : std::bool_constant<is_discard_v<typename T::inner_parser_t> ||
+                         description::is_guard_v<typename T::inner_parser_t>> {
+};
+template <class I, class T>
+constexpr static inline bool rewrites_v = rewrites<I, T>::value;
+
+template <class T>
+constexpr auto unwrap_discard(T&& t) {
+  if constexpr (is_discard_v<remove_cvref_t<T>>) {
+    return unwrap_discard(std::forward<T>(t).inner_parser());
+  }
+  else {
+    return remove_cvref_t<T>{std::forward<T>(t)};
+  }
+}
+
+template <class T>
+constexpr auto sequence_elements(T&& t);
+
+template <class C>
+constexpr auto sequence_element(C&& c) {
+  auto u = unwrap_discard(std::forward<C>(c));
+  using U = decltype(u);
+  if constexpr (is_plain_sequence_v<U>) {
+    return sequence_elements(std::move(u));
+  }
+  else {
+    return std::tuple<U>{std::move(u)};
+  }
+}
+
+template <class T, std::size_t... Is>
+constexpr auto sequence_elements(T&& t,
+                                 [[maybe_unused]] std::index_sequence<Is...>) {
+  return std::tuple_cat(
+      sequence_element(std::forward<T>(t).template parser<Is>())...);
+}
+
+template <class T>
+constexpr auto sequence_elements(T&& t) {
+  return sequence_elements(
+      std::forward<T>(t),
+      std::make_index_sequence<remove_cvref_t<T>::sequence_length>{});
+}
+
+template <class T, class... Ts>
+constexpr auto alternative_elements(T&& t);
+
+// Nested alternatives that may commit stay apart, the scope of their commits
+// ends with them.
+template <class C>
+constexpr auto alternative_element(C&& c) {
+  using U = remove_cvref_t<C>;
+  if constexpr (is_plain_alternative_v<U> && !description::may_commit_v<U>) {
+    return alternative_elements(std::forward<C>(c));
+  }
+  else {
+    return std::tuple<U>{std::forward<C>(c)};
+  }
+}
+
+template <class T, std::size_t... Is>
+constexpr auto alternative_elements(
+    T&& t,
+    [[maybe_unused]] std::index_sequence<Is...>) {
+  return std::tuple_cat(
+      alternative_element(std::forward<T>(t).template parser<Is>())...);
+}
+
+template <class T, class... Ts>
+constexpr auto alternative_elements(T&& t) {
+  return alternative_elements(
+      std::forward<T>(t),
+      std::make_index_sequence<remove_cvref_t<T>::sequence_length>{});
+}
+
+// Consecutive elements sharing a non-null key are merged together. The runs
+// are computed by a single constexpr loop over the keys of all the elements,
+// where walking the elements one at a time would instantiate a new pair of
+// tuples at each step.
+template <std::size_t N>
+struct run_plan {
+  std::size_t count = 0;
+  std::size_t start[N + 1] = {};  // start[count] == N
+};
+
+template <std::size_t N>
+constexpr run_plan<N> plan_runs(const void* const (&keys)[N + 1]) noexcept {
+  run_plan<N> plan{};
+  for (std::size_t i = 0; i < N; ++i) {
+    if (i == 0 || keys[i] == nullptr || keys[i] != keys[i - 1]) {
+      plan.start[plan.count++] = i;
+    }
+  }
+  plan.start[plan.count] = N;
+  return plan;
+}
+
+template <class Merge, class... Es>
+struct runs_of {
+  constexpr static inline const void* keys[] = {Merge::template key<Es>()...,
+                                                nullptr};
+  constexpr static inline run_plan<sizeof...(Es)> plan =
+      plan_runs<sizeof...(Es)>(keys);
+};
+
+template <class T>
+struct key_of {
+  constexpr static inline char value = 0;
+};
+
+template <class Merge,
+          std::size_t Start,
+          class Elements,
+          std::size_t... Is>
+constexpr auto merge_run(Elements&& elements,
+                         [[maybe_unused]] std::index_sequence<Is...>) {
+  if constexpr (sizeof...(Is) == 1) {
+    return std::get<Start>(std::move(elements));
+  }
+  else {
+    return Merge::merge(std::get<Start + Is>(std::move(elements))...);
+  }
+}
+
+template <class Merge, class... Es, std::size_t... Gs>
+constexpr auto merge_runs(std::tuple<Es...>&& elements,
+                          [[maybe_unused]] std::index_sequence<Gs...>) {
+  constexpr auto& plan = runs_of<Merge, Es...>::plan;
+  return std::make_tuple(merge_run<Merge, plan.start[Gs]>(
+      std::move(elements),
+      std::make_index_sequence<plan.start[Gs + 1] - plan.start[Gs]>{})...);
+}
+
+template <class Merge, class... Es>
+constexpr auto merge_runs(std::tuple<Es...>&& elements) {
+  return merge_runs<Merge>(
+      std::move(elements),
+      std::make_index_sequence<runs_of<Merge, Es...>::plan.count>{});
+}
+
+template <auto... Cs>
+struct character_storage {
+  constexpr static inline std::common_type_t<decltype(Cs)...> value[] = {
+      Cs...};
+};
+
+// Static characters of the same type become a static string.
+struct merge_characters {
+  template <class T>
+  constexpr static const void* key() noexcept {
+    if constexpr (is_static_character_v<T>) {
+      return &key_of<typename T::value_type>::value;
+    }
+    else {
+      return nullptr;
+    }
+  }
+
+  template <class... Cs>
+  constexpr static auto merge([[maybe_unused]] Cs&&... cs) {
+    using storage = character_storage<remove_cvref_t<Cs>::value...>;
+    using char_t = std::remove_cv_t<
+        std::remove_extent_t<std::remove_cv_t<decltype(storage::value)>>>;
+    return description::static_string<char_t>{
+        static_cast<const char_t*>(storage::value),
+        static_cast<const char_t*>(storage::value) + sizeof...(Cs)};
+  }
+};
+
+template <template <class...> class R, class T, class... Ts>
+constexpr auto rebuild(std::tuple<T, Ts...>&& elements) {
+  if constexpr (sizeof...(Ts) == 0) {
+    return std::get<0>(std::move(elements));
+  }
+  else {
+    return std::make_from_tuple<R<T, Ts...>>(std::move(elements));
+  }
+}
+
+template <class I, class D>
+constexpr auto rewrite(D&& desc) {
+  using T = remove_cvref_t<D>;
+  if constexpr (is_discard_v<T>) {
+    auto inner = std::forward<D>(desc).inner_parser();
+    if constexpr (rewrites_v<I, decltype(inner)>) {
+      return rewrite<I>(std::move(inner));
+    }
+    else {
+      return inner;
+    }
+  }
+  else if constexpr (is_plain_sequence_v<T>) {
+    return rebuild<description::sequence>(merge_runs<merge_characters>(
+        sequence_elements(std::forward<D>(desc))));
+  }
+  else {
+    return rebuild<description::alternative>(
+        alternative_elements(std::forward<D>(desc)));
+  }
+}
+}  // namespace detail
+
+template <class Interpreter = void, class Description>
+[[nodiscard]] constexpr decltype(auto) optimize(Description&& desc) noexcept {
+  if constexpr (detail::rewrites_v<Interpreter,
+                                   detail::remove_cvref_t<Description>>) {
+    return detail::rewrite<Interpreter>(std::forward<Description>(desc));
+  }
+  else {
+    return std::forward<Description>(desc);
+  }
+}
+
+}  // namespace parsers
+
+#endif  // GUARD_PARSERS_OPTIMIZE_HPP
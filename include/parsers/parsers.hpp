@@ -12,9 +12,15 @@
 #include "./description/dependent_modifiers.hpp"
 
 #include "./interpreter_traits.hpp"
+#include "./prepared.hpp"
+#include "./recovery.hpp"
+#include "./repetition_sizes.hpp"
 #include "./result_traits.hpp"
+#include "./rule.hpp"
 
+#include <cstdint>
 #include <iterator>
+#include <optional>
 #include <string_view>
 #include <type_traits>
 
@@ -32,6 +38,19 @@ template <class Descriptor, class T>
   auto e = end(input);
   return matcher(b, e);
 }
+
+template <class T>
+[[nodiscard]] constexpr auto contiguous_begin(const T& input) noexcept {
+  using std::data;
+  return data(input);
+}
+
+template <class T>
+[[nodiscard]] constexpr auto contiguous_end(const T& input) noexcept {
+  using std::data;
+  using std::size;
+  return data(input) + size(input);
+}
 }  // namespace detail
 
 template <class Descriptor, class T>
@@ -96,16 +115,38 @@ constexpr auto parse_range(Descriptor&& desc, const T& input) noexcept {
   return range_parser(begin(input), end(input));
 }
 
-namespace detail {
-struct extract_parser_result_t {
-  template <class U>
-  [[nodiscard]] constexpr typename std::decay_t<U>::second_type operator()(
-      U&& pair) const noexcept {
-    return std::get<1>(std::forward<U>(pair));
+// Runs on raw pointers into a contiguous input and reports positions as
+// offsets from its beginning, whatever its iterator type. The offsets must
+// fit in `Offset`.
+template <class Offset = std::uint32_t, class Descriptor, class T>
+[[nodiscard]] constexpr std::optional<Offset> match_offset(
+    Descriptor&& descriptor,
+    const T& input) noexcept {
+  const auto b = detail::contiguous_begin(input);
+  const auto matcher = interpreters::make_parser<interpreters::matcher>(
+      std::forward<Descriptor>(descriptor));
+  if (const auto r = matcher(b, detail::contiguous_end(input))) {
+    return static_cast<Offset>(*r - b);
   }
-};
-constexpr static inline extract_parser_result_t extract_parser_result{};
-}  // namespace detail
+  return std::nullopt;
+}
+
+template <class Offset = std::uint32_t, class Descriptor, class T>
+[[nodiscard]] constexpr dpsg::result<std::pair<Offset, Offset>, Offset>
+parse_offsets(Descriptor&& desc, const T& input) noexcept {
+  using result_t = dpsg::result<std::pair<Offset, Offset>, Offset>;
+  const auto b = detail::contiguous_begin(input);
+  const auto range_parser =
+      parsers::interpreters::make_parser<parsers::interpreters::range_parser>(
+          std::forward<Descriptor>(desc));
+  const auto r = range_parser(b, detail::contiguous_end(input));
+  if (r.has_value()) {
+    return result_t{dpsg::in_place_success,
+                    static_cast<Offset>(r->first - b),
+                    static_cast<Offset>(r->second - b)};
+  }
+  return result_t{dpsg::in_place_error, static_cast<Offset>(r.error() - b)};
+}
 
 template <class Description, class T>
 constexpr auto parse(Description&& desc, const T& input) noexcept {
@@ -116,6 +157,193 @@ constexpr auto parse(Description&& desc, const T& input) noexcept {
   return parser(begin(input), end(input)).map(detail::extract_parser_result);
 }
 
+// Same as `parse`, the errors recovered from by the `recover` descriptions
+// being added to `errors` with their offset into the input.
+template <class Description, class T>
+auto parse_recovering(Description&& desc, const T& input, error_log& errors) {
+  using std::begin, std::end;
+  const auto parser =
+      parsers::interpreters::make_parser<parsers::interpreters::object_parser>(
+          std::forward<Description>(desc));
+  const collect_errors collecting{errors, begin(input)};
+  return parser(begin(input), end(input)).map(detail::extract_parser_result);
+}
+
+// Same result as `parse`, but the input is first validated by a pass that
+// builds nothing and records the size of each repetition in `sizes`. The
+// result is then built with the vectors of the repetitions allocated once at
+// their final size. Invalid inputs cost a single pass and no allocation of
+// the result. `sizes` keeps its storage from one call to the next.
+template <class Description, class T>
+auto parse_two_phase(Description&& desc,
+                     const T& input,
+                     repetition_sizes& sizes) {
+  using std::begin, std::end;
+  const auto sizer =
+      parsers::interpreters::make_parser<parsers::interpreters::sizer>(desc);
+  const auto parser =
+      parsers::interpreters::make_parser<parsers::interpreters::object_parser>(
+          std::forward<Description>(desc));
+  using result_t = decltype(parser(begin(input), end(input))
+                                .map(detail::extract_parser_result));
+
+  sizes.record();
+  const use_repetition_sizes in_use{sizes};
+  const auto validated = sizer(begin(input), end(input));
+  if (!validated.has_value()) {
+    return result_t{dpsg::in_place_error, validated.error()};
+  }
+  sizes.replay();
+  return parser(begin(input), end(input)).map(detail::extract_parser_result);
+}
+
+template <class Description, class T>
+auto parse_two_phase(Description&& desc, const T& input) {
+  repetition_sizes sizes;
+  return parse_two_phase(std::forward<Description>(desc), input, sizes);
+}
+
+namespace detail {
+template <class T>
+constexpr const T& element_predicate(
+    const description::satisfy_character<T>& predicate) noexcept {
+  return static_cast<const T&>(predicate);
+}
+
+template <class D, class = void>
+struct is_element_predicate : std::false_type {};
+template <class D>
+struct is_element_predicate<
+    D,
+    std::void_t<decltype(detail::element_predicate(std::declval<const D&>()))>>
+    : std::true_type {};
+
+template <class T, class = void>
+struct is_contiguous_input : std::false_type {};
+template <class T>
+struct is_contiguous_input<
+    T,
+    std::void_t<decltype(std::data(std::declval<const T&>())),
+                decltype(std::size(std::declval<const T&>()))>>
+    : std::is_pointer<decltype(std::data(std::declval<const T&>()))> {};
+
+// Both loops check the elements by blocks whose comparisons don't depend on
+// each other and sum them in counters as narrow as the elements, which the
+// compiler turns into vector instructions.
+template <class It>
+using block_counter_t = std::conditional_t<
+    sizeof(typename std::iterator_traits<It>::value_type) == 1,
+    std::uint8_t,
+    std::uint32_t>;
+
+template <class P, class It, class E>
+[[nodiscard]] constexpr std::size_t count_leading(const P& predicate,
+                                                  It begin,
+                                                  E end) noexcept {
+  auto it = begin;
+  if constexpr (std::is_pointer_v<It>) {
+    constexpr std::ptrdiff_t block = 32;
+    while (end - it >= block) {
+      block_counter_t<It> matched = 0;
+      for (std::ptrdiff_t i = 0; i < block; ++i) {
+        matched += static_cast<bool>(predicate(it[i]));
+      }
+      if (matched != block) {
+        break;
+      }
+      it += block;
+    }
+  }
+  while (it != end && predicate(*it)) {
+    ++it;
+  }
+  return static_cast<std::size_t>(std::distance(begin, it));
+}
+
+template <class P, class It, class E>
+[[nodiscard]] constexpr std::size_t count_matching(const P& predicate,
+                                                   It begin,
+                                                   E end) noexcept {
+  std::size_t count = 0;
+  if constexpr (std::is_pointer_v<It>) {
+    constexpr std::ptrdiff_t block = 255;
+    while (end - begin >= block) {
+      block_counter_t<It> matched = 0;
+      for (std::ptrdiff_t i = 0; i < block; ++i) {
+        matched += static_cast<bool>(predicate(begin[i]));
+      }
+      count += matched;
+      begin += block;
+    }
+  }
+  for (; begin != end; ++begin) {
+    count += static_cast<std::size_t>(static_cast<bool>(predicate(*begin)));
+  }
+  return count;
+}
+
+template <bool All, class Descriptor, class T>
+[[nodiscard]] constexpr std::size_t count(Descriptor&& descriptor,
+                                          const T& input) noexcept {
+  using std::begin;
+  using std::end;
+  if constexpr (is_element_predicate<remove_cvref_t<Descriptor>>::value) {
+    const auto& predicate = detail::element_predicate(descriptor);
+    if constexpr (is_contiguous_input<T>::value) {
+      return All ? count_matching(predicate,
+                                  contiguous_begin(input),
+                                  contiguous_end(input))
+                 : count_leading(predicate,
+                                 contiguous_begin(input),
+                                 contiguous_end(input));
+    }
+    else {
+      return All ? count_matching(predicate, begin(input), end(input))
+                 : count_leading(predicate, begin(input), end(input));
+    }
+  }
+  else {
+    const auto matcher = interpreters::make_parser<interpreters::matcher>(
+        std::forward<Descriptor>(descriptor));
+    std::size_t found = 0;
+    auto it = begin(input);
+    const auto e = end(input);
+    while (it != e) {
+      const auto r = matcher(it, e);
+      if (r && *r != it) {
+        ++found;
+        it = *r;
+      }
+      else if constexpr (All) {
+        ++it;
+      }
+      else {
+        break;
+      }
+    }
+    return found;
+  }
+}
+}  // namespace detail
+
+// Number of times `descriptor` matches back to back from the beginning of the
+// input, that is the size of what `many` would produce, without building
+// anything. Matches that consume no input are not counted.
+template <class Descriptor, class T>
+[[nodiscard]] constexpr std::size_t count(Descriptor&& descriptor,
+                                          const T& input) noexcept {
+  return detail::count<false>(std::forward<Descriptor>(descriptor), input);
+}
+
+// Number of non-overlapping matches of `descriptor` anywhere in the input,
+// searching from the left and resuming after each match. Matches that consume
+// no input are not counted.
+template <class Descriptor, class T>
+[[nodiscard]] constexpr std::size_t count_all(Descriptor&& descriptor,
+                                              const T& input) noexcept {
+  return detail::count<true>(std::forward<Descriptor>(descriptor), input);
+}
+
 }  // namespace parsers
 
 #endif  // GUARD_PARSERS_HPP
\ No newline at end of file
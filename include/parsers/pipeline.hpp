@@ -0,0 +1,315 @@
+#ifndef GUARD_PARSERS_PIPELINE_HPP
+#define GUARD_PARSERS_PIPELINE_HPP
+
+#include "./interpreter_traits.hpp"
+#include "./interpreters.hpp"
+#include "./prepared.hpp"
+#include "./result_traits.hpp"
+#include "./utility/spsc_queue.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace parsers {
+
+struct pipeline_options {
+  std::size_t parsers = 2;
+  std::size_t chunk_size = std::size_t{1} << 16U;
+  std::size_t queue_depth = 8;
+  char delimiter = '\n';
+};
+
+struct pipeline_statistics {
+  std::uint64_t bytes_read = 0;
+  std::uint64_t chunks = 0;
+  std::uint64_t records = 0;
+  std::uint64_t failures = 0;
+  std::uint64_t reader_stalls = 0;
+  std::uint64_t parser_stalls = 0;
+  std::uint64_t consumer_stalls = 0;
+};
+
+template <class Description>
+class pipeline {
+ public:
+  using description_t = Description;
+  using iterator = const char*;
+  using value_type = parsers::
+      interpreter_value_type<interpreters::object_parser, iterator, Description>;
+
+  template <class D,
+            std::enable_if_t<!std::is_same_v<std::decay_t<D>, pipeline>,
+                             int> = 0>
+  explicit pipeline(D&& desc, pipeline_options options = {})
+      : _parser{std::forward<D>(desc)}, _options{sanitize(options)} {}
+
+  template <class Reader, class Consumer>
+  pipeline_statistics run(Reader&& read, Consumer&& consume) {
+    _reset_counters();
+    const std::size_t chunk_count =
+        _options.parsers * (_options.queue_depth + 1) + 1;
+    std::vector<std::unique_ptr<chunk>> chunks;
+    dpsg::spsc_queue<chunk*> free_chunks{chunk_count};
+    for (std::size_t i = 0; i < chunk_count; ++i) {
+      chunks.push_back(std::make_unique<chunk>());
+      chunks.back()->data.reserve(_options.chunk_size);
+      static_cast<void>(free_chunks.try_push(chunks.back().get()));
+    }
+
+    std::vector<std::unique_ptr<stage>> stages;
+    for (std::size_t i = 0; i < _options.parsers; ++i) {
+      stages.push_back(std::make_unique<stage>(_options.queue_depth));
+    }
+
+    _stopping.store(false, std::memory_order_relaxed);
+    std::exception_ptr read_error;
+    std::vector<std::thread> threads;
+    const joining_guard guard{*this, threads};
+    for (auto& s : stages) {
+      threads.emplace_back([this, &s] { _parse(*s); });
+    }
+    threads.emplace_back([this, &read, &free_chunks, &stages, &read_error] {
+      try {
+        _read(read, free_chunks, stages);
+      }
+      catch (...) {
+        read_error = std::current_exception();
+        _stop();
+      }
+    });
+
+    _consume(consume, free_chunks, stages);
+
+    for (auto& t : threads) {
+      t.join();
+    }
+    if (read_error) {
+      std::rethrow_exception(read_error);
+    }
+    return statistics();
+  }
+
+  [[nodiscard]] pipeline_statistics statistics() const noexcept {
+    constexpr auto relaxed = std::memory_order_relaxed;
+    return pipeline_statistics{_bytes_read.load(relaxed),
+                               _chunks.load(relaxed),
+                               _records.load(relaxed),
+                               _failures.load(relaxed),
+                               _reader_stalls.load(relaxed),
+                               _parser_stalls.load(relaxed),
+                               _consumer_stalls.load(relaxed)};
+  }
+
+ private:
+  struct chunk {
+    std::vector<char> data;
+    std::vector<value_type> results;
+  };
+
+  struct stage {
+    explicit stage(std::size_t depth) : input{depth}, output{depth} {}
+    dpsg::spsc_queue<chunk*> input;
+    dpsg::spsc_queue<chunk*> output;
+  };
+
+  // Leaving `run` through an exception stops the stages before joining the
+  // threads, which would otherwise wait on each other forever.
+  struct joining_guard {
+    pipeline& self;
+    std::vector<std::thread>& threads;
+
+    ~joining_guard() {
+      if (std::any_of(threads.begin(), threads.end(), [](const auto& t) {
+            return t.joinable();
+          })) {
+        self._stop();
+      }
+      for (auto& t : threads) {
+        if (t.joinable()) {
+          t.join();
+        }
+      }
+    }
+  };
+
+  void _stop() noexcept { _stopping.store(true, std::memory_order_release); }
+  [[nodiscard]] bool _stopped() const noexcept {
+    return _stopping.load(std::memory_order_acquire);
+  }
+
+  [[nodiscard]] static pipeline_options sanitize(
+      pipeline_options options) noexcept {
+    options.parsers = std::max<std::size_t>(options.parsers, 1);
+    options.chunk_size = std::max<std::size_t>(options.chunk_size, 1);
+    options.queue_depth = std::max<std::size_t>(options.queue_depth, 1);
+    return options;
+  }
+
+  // Once the pipeline is stopped, `pop` gives null chunks and `push` drops
+  // them, so that every stage runs to its end.
+  template <class T>
+  T pop(dpsg::spsc_queue<T>& queue, std::atomic<std::uint64_t>& stalls) {
+    while (true) {
+      if (auto value = queue.try_pop()) {
+        return *std::move(value);
+      }
+      if (_stopped()) {
+        return T{};
+      }
+      stalls.fetch_add(1, std::memory_order_relaxed);
+      std::this_thread::yield();
+    }
+  }
+
+  template <class T>
+  void push(dpsg::spsc_queue<T>& queue,
+            T value,
+            std::atomic<std::uint64_t>& stalls) {
+    while (!queue.try_push(value)) {
+      if (_stopped()) {
+        return;
+      }
+      stalls.fetch_add(1, std::memory_order_relaxed);
+      std::this_thread::yield();
+    }
+  }
+
+  template <class Reader>
+  void _read(Reader& read,
+             dpsg::spsc_queue<chunk*>& free_chunks,
+             std::vector<std::unique_ptr<stage>>& stages) {
+    std::vector<char> carry;
+    std::size_t next_stage = 0;
+    bool eof = false;
+    while (!eof) {
+      chunk* c = pop(free_chunks, _reader_stalls);
+      if (c == nullptr) {
+        return;
+      }
+      auto& data = c->data;
+      data.assign(carry.begin(), carry.end());
+      carry.clear();
+
+      std::size_t searched = 0;
+      while (true) {
+        const auto filled = data.size();
+        data.resize(std::max(filled + _options.chunk_size, data.capacity()));
+        const std::size_t n = read(data.data() + filled, data.size() - filled);
+        data.resize(filled + n);
+        _bytes_read.fetch_add(n, std::memory_order_relaxed);
+        if (n == 0) {
+          eof = true;
+          break;
+        }
+        const auto last = std::find(data.rbegin(),
+                                    data.rend() - static_cast<std::ptrdiff_t>(
+                                                      searched),
+                                    _options.delimiter);
+        if (last != data.rend() - static_cast<std::ptrdiff_t>(searched)) {
+          const auto split = data.size() - static_cast<std::size_t>(
+                                               last - data.rbegin());
+          carry.assign(data.begin() + static_cast<std::ptrdiff_t>(split),
+                       data.end());
+          data.resize(split);
+          break;
+        }
+        searched = data.size();
+      }
+
+      if (data.empty()) {
+        break;
+      }
+      _chunks.fetch_add(1, std::memory_order_relaxed);
+      push(stages[next_stage]->input, c, _reader_stalls);
+      next_stage = (next_stage + 1) % stages.size();
+    }
+    for (std::size_t i = 0; i < stages.size(); ++i) {
+      push(stages[(next_stage + i) % stages.size()]->input,
+           static_cast<chunk*>(nullptr),
+           _reader_stalls);
+    }
+  }
+
+  void _parse(stage& s) {
+    // Parsers may hold state (e.g. the cache of a `cached_bind`), each
+    // thread uses its own copy.
+    const auto parser = _parser;
+    while (chunk* c = pop(s.input, _parser_stalls)) {
+      c->results.clear();
+      const char* beg = c->data.data();
+      const char* const end = beg + c->data.size();
+      while (beg != end) {
+        const char* eol = std::find(beg, end, _options.delimiter);
+        auto r = parser(beg, eol);
+        if (parsers::has_value(r)) {
+          c->results.push_back(parsers::value(std::move(r)));
+        }
+        else {
+          _failures.fetch_add(1, std::memory_order_relaxed);
+        }
+        beg = eol == end ? end : eol + 1;
+      }
+      _records.fetch_add(c->results.size(), std::memory_order_relaxed);
+      push(s.output, c, _parser_stalls);
+    }
+    push(s.output, static_cast<chunk*>(nullptr), _parser_stalls);
+  }
+
+  template <class Consumer>
+  void _consume(Consumer& consume,
+                dpsg::spsc_queue<chunk*>& free_chunks,
+                std::vector<std::unique_ptr<stage>>& stages) {
+    std::size_t next_stage = 0;
+    while (chunk* c = pop(stages[next_stage]->output, _consumer_stalls)) {
+      for (auto& r : c->results) {
+        consume(std::move(r));
+      }
+      push(free_chunks, c, _consumer_stalls);
+      next_stage = (next_stage + 1) % stages.size();
+    }
+    for (std::size_t i = 1; i < stages.size(); ++i) {
+      static_cast<void>(pop(stages[(next_stage + i) % stages.size()]->output,
+                            _consumer_stalls));
+    }
+  }
+
+  void _reset_counters() noexcept {
+    for (auto* counter : {&_bytes_read,
+                          &_chunks,
+                          &_records,
+                          &_failures,
+                          &_reader_stalls,
+                          &_parser_stalls,
+                          &_consumer_stalls}) {
+      counter->store(0, std::memory_order_relaxed);
+    }
+  }
+
+  prepared_parser<interpreters::object_parser, Description> _parser;
+  pipeline_options _options;
+
+  std::atomic<std::uint64_t> _bytes_read{0};
+  std::atomic<std::uint64_t> _chunks{0};
+  std::atomic<std::uint64_t> _records{0};
+  std::atomic<std::uint64_t> _failures{0};
+  std::atomic<std::uint64_t> _reader_stalls{0};
+  std::atomic<std::uint64_t> _parser_stalls{0};
+  std::atomic<std::uint64_t> _consumer_stalls{0};
+  std::atomic<bool> _stopping{false};
+};
+template <class D>
+pipeline(D&&) -> pipeline<detail::remove_cvref_t<D>>;
+template <class D>
+pipeline(D&&, pipeline_options) -> pipeline<detail::remove_cvref_t<D>>;
+
+}  // namespace parsers
+
+#endif  // GUARD_PARSERS_PIPELINE_HPP
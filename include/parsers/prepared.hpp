@@ -0,0 +1,103 @@
+#ifndef GUARD_PARSERS_PREPARED_HPP
+#define GUARD_PARSERS_PREPARED_HPP
+
+#include "./interpreters.hpp"
+#include "./result_traits.hpp"
+#include "./utility.hpp"
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace parsers {
+
+template <class Interpreter, class Description>
+struct prepared_parser {
+  using interpreter_t = Interpreter;
+  using description_t = Description;
+  using parser_t = decltype(interpreters::make_parser<interpreter_t>(
+      std::declval<const description_t&>()));
+
+  template <class D,
+            std::enable_if_t<!std::is_same_v<std::decay_t<D>, prepared_parser>,
+                             int> = 0>
+  constexpr explicit prepared_parser(D&& descriptor) noexcept
+      : _parser{interpreters::make_parser<interpreter_t>(
+            std::forward<D>(descriptor))} {}
+
+  template <class ItB, class ItE>
+  [[nodiscard]] constexpr auto operator()(ItB beg, ItE end) const noexcept {
+    return _parser(beg, end);
+  }
+
+  template <class T>
+  [[nodiscard]] constexpr auto operator()(const T& input) const noexcept {
+    using std::begin;
+    using std::end;
+    return _parser(begin(input), end(input));
+  }
+
+  [[nodiscard]] constexpr const parser_t& parser() const noexcept {
+    return _parser;
+  }
+
+ private:
+  parser_t _parser;
+};
+
+template <class Interpreter = interpreters::object_parser, class Description>
+[[nodiscard]] constexpr auto prepare(Description&& desc) noexcept {
+  return prepared_parser<Interpreter, detail::remove_cvref_t<Description>>{
+      std::forward<Description>(desc)};
+}
+
+namespace detail {
+struct extract_parser_result_t {
+  template <class U>
+  [[nodiscard]] constexpr typename std::decay_t<U>::second_type operator()(
+      U&& pair) const noexcept {
+    return std::get<1>(std::forward<U>(pair));
+  }
+};
+constexpr static inline extract_parser_result_t extract_parser_result{};
+
+template <class T, class = void>
+struct has_size : std::false_type {};
+template <class T>
+struct has_size<T, std::void_t<decltype(std::size(std::declval<const T&>()))>>
+    : std::true_type {};
+
+template <class T, class = void>
+struct has_reserve : std::false_type {};
+template <class T>
+struct has_reserve<
+    T,
+    std::void_t<decltype(std::declval<T&>().reserve(std::size_t{}))>>
+    : std::true_type {};
+}  // namespace detail
+
+template <class Description, class Inputs, class Out>
+std::size_t parse_batch(
+    const prepared_parser<interpreters::object_parser, Description>& prepared,
+    const Inputs& inputs,
+    Out& out) {
+  out.clear();
+  if constexpr (std::conjunction_v<detail::has_size<Inputs>,
+                                   detail::has_reserve<Out>>) {
+    out.reserve(std::size(inputs));
+  }
+  std::size_t successes = 0;
+  for (const auto& input : inputs) {
+    auto r = prepared(input).map(detail::extract_parser_result);
+    if (r.has_value()) {
+      ++successes;
+    }
+    out.push_back(std::move(r));
+  }
+  return successes;
+}
+
+}  // namespace parsers
+
+#endif  // GUARD_PARSERS_PREPARED_HPP
@@ -0,0 +1,377 @@
+#ifndef GUARD_PARSERS_PROFILING_HPP
+#define GUARD_PARSERS_PROFILING_HPP
+
+#include "./allocations.hpp"
+#include "./interpreters.hpp"
+#include "./result_traits.hpp"
+#include "./utility.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace parsers {
+
+namespace detail {
+template <class T>
+[[nodiscard]] constexpr std::string_view type_name() noexcept {
+#if defined(_MSC_VER)
+  constexpr std::string_view signature = __FUNCSIG__;
+  constexpr auto first = signature.find("type_name<") + 10;
+  constexpr auto last = signature.rfind(">(void)");
+#else
+  constexpr std::string_view signature = __PRETTY_FUNCTION__;
+  constexpr auto first = signature.find("T = ") + 4;
+  constexpr auto semicolon = signature.find(';', first);
+  constexpr auto last =
+      semicolon == std::string_view::npos ? signature.rfind(']') : semicolon;
+#endif
+  return signature.substr(first, last - first);
+}
+
+inline std::string_view short_type_name(std::string_view name) noexcept {
+  for (std::string_view prefix :
+       {"parsers::description::", "parsers::", "ascii::"}) {
+    if (name.substr(0, prefix.size()) == prefix) {
+      name.remove_prefix(prefix.size());
+    }
+  }
+  const auto bracket = name.find('<');
+  if (name.size() > 40 && bracket != std::string_view::npos) {
+    return name.substr(0, bracket);
+  }
+  return name;
+}
+
+inline void escape_json(std::string& out, std::string_view text) {
+  for (char c : text) {
+    if (c == '"' || c == '\\') {
+      out += '\\';
+      out += c;
+    }
+    else if (static_cast<unsigned char>(c) < 0x20) {
+      constexpr char digits[] = "0123456789abcdef";
+      out += "\\u00";
+      out += digits[(c >> 4) & 0xF];
+      out += digits[c & 0xF];
+    }
+    else {
+      out += c;
+    }
+  }
+}
+}  // namespace detail
+
+// Statistics per description node, collected by the `profiling`
+// interpreter. Nodes form a calling-context tree: a node is identified by
+// the type of its description, its rank among the parsers built by its
+// parent and the node it was called from. Recursive calls are folded into
+// the node they re-enter, whose time only counts the outermost call.
+class profile {
+ public:
+  constexpr static inline std::size_t no_parent = static_cast<std::size_t>(-1);
+
+  struct node {
+    std::string_view name;
+    std::size_t parent;
+    std::uint32_t rank;
+    std::uint32_t depth;
+    std::uint64_t invocations = 0;
+    std::uint64_t successes = 0;
+    std::uint64_t failures = 0;
+    // Consumed by successful invocations.
+    std::uint64_t bytes_consumed = 0;
+    // Read by failed invocations before failing, hence read again by
+    // whatever is tried next.
+    std::uint64_t bytes_rescanned = 0;
+    std::chrono::nanoseconds time{};
+    std::chrono::nanoseconds self_time{};
+    // Made by the object parser, see `allocation_count`. Like the times,
+    // these include the nested nodes and count the outermost call of a
+    // recursive node, the self counts leaving out the nested nodes.
+    std::uint64_t allocations = 0;
+    std::uint64_t allocated_bytes = 0;
+    std::uint64_t self_allocations = 0;
+    std::uint64_t self_allocated_bytes = 0;
+  };
+
+  [[nodiscard]] const std::vector<node>& nodes() const noexcept {
+    return _nodes;
+  }
+
+  void clear() noexcept {
+    _nodes.clear();
+    _links.clear();
+    _active.clear();
+    _frames.assign(1, frame{no_parent, 0});
+  }
+
+  // One line per node, the most expensive first.
+  [[nodiscard]] std::string report() const {
+    std::vector<std::size_t> order(_nodes.size());
+    for (std::size_t i = 0; i < order.size(); ++i) {
+      order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [this](auto a, auto b) {
+      return _nodes[a].self_time > _nodes[b].self_time;
+    });
+    std::string out =
+        "  self(ns)  total(ns)     calls      fails   consumed  rescanned  "
+        "    allocs  alloc(B)  node\n";
+    for (auto i : order) {
+      const auto& n = _nodes[i];
+      append_column(out, n.self_time.count(), 10);
+      append_column(out, n.time.count(), 11);
+      append_column(out, n.invocations, 10);
+      append_column(out, n.failures, 11);
+      append_column(out, n.bytes_consumed, 11);
+      append_column(out, n.bytes_rescanned, 11);
+      append_column(out, n.self_allocations, 10);
+      append_column(out, n.self_allocated_bytes, 10);
+      out += "  ";
+      append_path(out, i);
+      out += '\n';
+    }
+    return out;
+  }
+
+  [[nodiscard]] std::string json() const {
+    std::string out = "[";
+    for (std::size_t i = 0; i < _nodes.size(); ++i) {
+      const auto& n = _nodes[i];
+      out += i == 0 ? "\n" : ",\n";
+      out += "  {\"id\": " + std::to_string(i) + ", \"parent\": ";
+      out += n.parent == no_parent ? "null" : std::to_string(n.parent);
+      out += ", \"rank\": " + std::to_string(n.rank) + ", \"type\": \"";
+      detail::escape_json(out, n.name);
+      out += "\", \"invocations\": " + std::to_string(n.invocations) +
+             ", \"successes\": " + std::to_string(n.successes) +
+             ", \"failures\": " + std::to_string(n.failures) +
+             ", \"bytes_consumed\": " + std::to_string(n.bytes_consumed) +
+             ", \"bytes_rescanned\": " + std::to_string(n.bytes_rescanned) +
+             ", \"time_ns\": " + std::to_string(n.time.count()) +
+             ", \"self_time_ns\": " + std::to_string(n.self_time.count()) +
+             ", \"allocations\": " + std::to_string(n.allocations) +
+             ", \"allocated_bytes\": " + std::to_string(n.allocated_bytes) +
+             ", \"self_allocations\": " + std::to_string(n.self_allocations) +
+             ", \"self_allocated_bytes\": " +
+             std::to_string(n.self_allocated_bytes) + "}";
+    }
+    out += "\n]\n";
+    return out;
+  }
+
+  std::uint32_t begin_construction() {
+    const auto rank = _frames.back().built++;
+    _frames.push_back(frame{no_parent, 0});
+    return rank;
+  }
+
+  void end_construction() noexcept { _frames.pop_back(); }
+
+  std::size_t enter(std::string_view name, std::uint32_t rank) {
+    const auto caller = _frames.back().node;
+    const auto id = find_or_add(caller, name, rank);
+    _frames.push_back(frame{id, 0});
+    ++_active[id];
+    return id;
+  }
+
+  void leave(std::size_t id,
+             bool success,
+             std::uint64_t bytes,
+             std::chrono::nanoseconds elapsed,
+             const allocation_count& allocated = {}) noexcept {
+    _frames.pop_back();
+    auto& n = _nodes[id];
+    ++n.invocations;
+    if (success) {
+      ++n.successes;
+      n.bytes_consumed += bytes;
+    }
+    else {
+      ++n.failures;
+      n.bytes_rescanned += bytes;
+    }
+    if (--_active[id] == 0) {
+      n.time += elapsed;
+      n.self_time += elapsed;
+      n.allocations += allocated.allocations;
+      n.allocated_bytes += allocated.bytes;
+      n.self_allocations += allocated.allocations;
+      n.self_allocated_bytes += allocated.bytes;
+      for (auto caller = _frames.rbegin(); caller != _frames.rend();
+           ++caller) {
+        if (caller->node != no_parent) {
+          if (_active[caller->node] == 1) {
+            auto& c = _nodes[caller->node];
+            c.self_time -= elapsed;
+            c.self_allocations -= allocated.allocations;
+            c.self_allocated_bytes -= allocated.bytes;
+          }
+          break;
+        }
+      }
+    }
+  }
+
+ private:
+  struct frame {
+    std::size_t node;
+    std::uint32_t built;
+  };
+
+  struct link {
+    std::size_t caller;
+    std::string_view name;
+    std::uint32_t rank;
+    std::size_t target;
+  };
+
+  std::size_t find_or_add(std::size_t caller,
+                          std::string_view name,
+                          std::uint32_t rank) {
+    for (const auto& l : _links) {
+      if (l.caller == caller && l.rank == rank && l.name == name) {
+        return l.target;
+      }
+    }
+    std::size_t target = no_parent;
+    for (auto f = _frames.rbegin(); f != _frames.rend(); ++f) {
+      if (f->node != no_parent && _nodes[f->node].rank == rank &&
+          _nodes[f->node].name == name) {
+        target = f->node;
+        break;
+      }
+    }
+    if (target == no_parent) {
+      target = _nodes.size();
+      node n{};
+      n.name = name;
+      n.parent = caller;
+      n.rank = rank;
+      n.depth = caller == no_parent ? 0 : _nodes[caller].depth + 1;
+      _nodes.push_back(n);
+      _active.push_back(0);
+    }
+    _links.push_back(link{caller, name, rank, target});
+    return target;
+  }
+
+  static void append_column(std::string& out,
+                            std::uint64_t value,
+                            std::size_t width) {
+    const auto text = std::to_string(value);
+    if (text.size() < width) {
+      out.append(width - text.size(), ' ');
+    }
+    out += text;
+  }
+
+  void append_path(std::string& out, std::size_t id) const {
+    const auto& n = _nodes[id];
+    if (n.parent != no_parent) {
+      append_path(out, n.parent);
+      out += " > ";
+    }
+    out += std::to_string(n.rank);
+    out += ':';
+    out += detail::short_type_name(n.name);
+  }
+
+  std::vector<node> _nodes;
+  std::vector<std::uint32_t> _active;
+  std::vector<link> _links;
+  std::vector<frame> _frames{frame{no_parent, 0}};
+};
+
+namespace detail {
+template <class P>
+struct profiled_parser {
+  P parser;
+  profile* target;
+  std::string_view name;
+  std::uint32_t rank;
+
+  template <class ItB, class ItE>
+  auto operator()(ItB begin, ItE end) const -> decltype(parser(begin, end)) {
+    using clock = std::chrono::steady_clock;
+    allocation_count allocated;
+    const count_allocations counting{allocated};
+    const auto id = target->enter(name, rank);
+    const auto start = clock::now();
+    auto result = parser(begin, end);
+    const auto elapsed = clock::now() - start;
+    target->leave(id,
+                  has_value(result),
+                  progress(begin, result),
+                  elapsed,
+                  allocated);
+    return result;
+  }
+
+ private:
+  template <class ItB, class R>
+  static std::uint64_t progress(ItB begin, const R& result) noexcept {
+    if (has_value(result)) {
+      return static_cast<std::uint64_t>(
+          std::distance(begin, next_iterator(result)));
+    }
+    else if constexpr (std::is_convertible_v<
+                           typename result_traits<R>::failure_type,
+                           ItB>) {
+      return static_cast<std::uint64_t>(
+          std::distance(begin, static_cast<ItB>(result.error())));
+    }
+    else {
+      return 0;
+    }
+  }
+};
+}  // namespace detail
+
+// Wraps an interpreter so that each parser it builds records its calls in
+// a `profile`. Descriptions run by an automaton appear as a single node.
+// With `Enabled` false, nothing is recorded and the parsers are those of
+// `Interpreter`.
+template <class Interpreter, bool Enabled = true>
+struct profiling : Interpreter {
+  constexpr static inline bool instruments = Enabled;
+
+  constexpr explicit profiling(profile& target) noexcept : _profile{&target} {}
+
+  template <class D, class F>
+  auto instrument([[maybe_unused]] type_t<D> description, F&& build) const {
+    const auto rank = _profile->begin_construction();
+    auto parser = std::forward<F>(build)();
+    _profile->end_construction();
+    return detail::profiled_parser<decltype(parser)>{
+        std::move(parser), _profile, detail::type_name<D>(), rank};
+  }
+
+ private:
+  profile* _profile;
+};
+
+template <class Interpreter>
+struct profiling<Interpreter, false> : Interpreter {
+  constexpr explicit profiling([[maybe_unused]] profile& target) noexcept {}
+};
+
+template <class Interpreter, bool Enabled = true, class Description>
+[[nodiscard]] auto make_profiled_parser(Description&& desc, profile& target) {
+  return interpreters::make_parser_t<profiling<Interpreter, Enabled>>{
+      profiling<Interpreter, Enabled>{target}}(
+      std::forward<Description>(desc));
+}
+
+}  // namespace parsers
+
+#endif  // GUARD_PARSERS_PROFILING_HPP
@@ -0,0 +1,124 @@
+#ifndef GUARD_PARSERS_RECOVERY_HPP
+#define GUARD_PARSERS_RECOVERY_HPP
+
+#include "./utility.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace parsers {
+
+// An error recovered from by a `recover` description: where its inner
+// description stopped (where it started for interpreters that don't report
+// failure positions, like the matcher) and the id given to the `recover`.
+struct parse_error {
+  constexpr static inline std::size_t unknown_offset =
+      std::numeric_limits<std::size_t>::max();
+
+  std::size_t offset;
+  std::uint32_t expected;
+
+  friend constexpr bool operator==(const parse_error& left,
+                                   const parse_error& right) noexcept {
+    return left.offset == right.offset && left.expected == right.expected;
+  }
+};
+
+// Errors collected while parsing. The storage is allocated once, errors past
+// the capacity are only counted. `clear` keeps the storage for the next
+// input.
+class error_log {
+ public:
+  explicit error_log(std::size_t capacity = 1024) : _capacity{capacity} {
+    _errors.reserve(capacity);
+  }
+
+  [[nodiscard]] const std::vector<parse_error>& errors() const noexcept {
+    return _errors;
+  }
+
+  [[nodiscard]] std::size_t size() const noexcept { return _errors.size(); }
+
+  [[nodiscard]] bool empty() const noexcept { return _errors.empty(); }
+
+  [[nodiscard]] std::uint64_t dropped() const noexcept { return _dropped; }
+
+  void add(parse_error error) noexcept {
+    if (_errors.size() < _capacity) {
+      _errors.push_back(error);
+    }
+    else {
+      ++_dropped;
+    }
+  }
+
+  void clear() noexcept {
+    _errors.clear();
+    _dropped = 0;
+  }
+
+ private:
+  std::vector<parse_error> _errors;
+  std::size_t _capacity;
+  std::uint64_t _dropped = 0;
+};
+
+namespace detail {
+// The log of the current thread and the beginning of the input, offsets
+// being only computed for positions of the same iterator type.
+struct error_sink {
+  error_log* log = nullptr;
+  const void* begin = nullptr;
+  const void* iterator = nullptr;
+};
+
+inline error_sink& current_error_sink() noexcept {
+  thread_local error_sink sink;
+  return sink;
+}
+
+template <class It>
+void report_error(It position, std::uint32_t expected) noexcept {
+  const auto& sink = current_error_sink();
+  if (sink.log == nullptr) {
+    return;
+  }
+  auto offset = parse_error::unknown_offset;
+  if (sink.iterator == &type_key<It>::id) {
+    offset = static_cast<std::size_t>(
+        std::distance(*static_cast<const It*>(sink.begin), position));
+  }
+  sink.log->add(parse_error{offset, expected});
+}
+}  // namespace detail
+
+// Makes `log` collect the errors recovered from on the current thread for as
+// long as it lives, with offsets counted from `begin`. Without a scope,
+// recovering costs a thread-local read per error.
+template <class It>
+class collect_errors {
+ public:
+  collect_errors(error_log& log, It begin) noexcept
+      : _begin{std::move(begin)},
+        _enclosing{std::exchange(
+            detail::current_error_sink(),
+            detail::error_sink{&log, &_begin, &detail::type_key<It>::id})} {
+  }
+
+  collect_errors(const collect_errors&) = delete;
+  collect_errors& operator=(const collect_errors&) = delete;
+
+  ~collect_errors() noexcept { detail::current_error_sink() = _enclosing; }
+
+ private:
+  It _begin;
+  detail::error_sink _enclosing;
+};
+
+}  // namespace parsers
+
+#endif  // GUARD_PARSERS_RECOVERY_HPP
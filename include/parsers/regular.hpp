@@ -0,0 +1,409 @@
+#ifndef GUARD_PARSERS_REGULAR_HPP
+#define GUARD_PARSERS_REGULAR_HPP
+
+#include "./description.hpp"
+#include "./interpreters/customization_points.hpp"
+#include "./optimize.hpp"
+#include "./utility.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace parsers::regular {
+namespace detail {
+using namespace ::parsers::detail;
+
+constexpr static inline std::size_t max_steps = 32;
+constexpr static inline std::size_t alphabet_size = 256;
+constexpr static inline std::size_t ascii_size = 128;
+constexpr static inline std::size_t not_regular = static_cast<std::size_t>(-1);
+
+template <class T>
+constexpr std::true_type is_ascii_class_f(
+    const description::ascii::character_class<T>&) noexcept;
+constexpr std::false_type is_ascii_class_f(...) noexcept;
+template <class T>
+constexpr static inline bool is_ascii_class_v =
+    decltype(is_ascii_class_f(std::declval<T>()))::value;
+
+template <class T, class = void>
+struct is_byte_predicate : std::false_type {};
+template <auto C, class T>
+struct is_byte_predicate<description::character<C, T>>
+    : std::is_integral<T> {};
+template <auto C, class T>
+struct is_byte_predicate<description::ascii::case_insensitive_character<C, T>>
+    : std::is_integral<T> {};
+template <>
+struct is_byte_predicate<description::any_t> : std::true_type {};
+template <class T>
+struct is_byte_predicate<
+    T,
+    std::enable_if_t<is_ascii_class_v<T> && std::is_empty_v<T>>>
+    : std::true_type {};
+
+template <class T>
+struct is_byte_set : is_byte_predicate<T> {};
+template <class... Ts>
+struct is_byte_set<description::alternative<Ts...>>
+    : std::conjunction<is_byte_set<Ts>...> {};
+template <class A, class B>
+struct is_byte_set<description::either<A, B>>
+    : std::conjunction<is_byte_set<A>, is_byte_set<B>> {};
+
+template <std::size_t N, class P>
+struct repetition {
+  using parser_t = P;
+  constexpr static inline std::size_t count = N;
+};
+template <std::size_t N, class P, class C>
+repetition<N, P> as_repetition_f(
+    const description::at_least<description::detail::static_count<N>, P, C>&)
+    noexcept;
+void as_repetition_f(...) noexcept;
+template <class T>
+using repetition_t = decltype(as_repetition_f(std::declval<T>()));
+
+template <class... Ts>
+[[nodiscard]] constexpr std::size_t sum_steps(Ts... counts) noexcept {
+  std::size_t total = 0;
+  for (std::size_t c : {std::size_t{0}, static_cast<std::size_t>(counts)...}) {
+    if (c == not_regular || total + c > max_steps) {
+      return not_regular;
+    }
+    total += c;
+  }
+  return total;
+}
+
+template <class T, class = void>
+struct step_count
+    : std::integral_constant<std::size_t,
+                             is_byte_set<T>::value ? 1 : not_regular> {};
+template <class... Ts>
+struct step_count<description::sequence<Ts...>>
+    : std::integral_constant<std::size_t,
+                             sum_steps(step_count<Ts>::value...)> {};
+template <class A, class B>
+struct step_count<description::both<A, B>>
+    : std::integral_constant<std::size_t,
+                             sum_steps(step_count<A>::value,
+                                       step_count<B>::value)> {};
+template <class T>
+struct step_count<T, std::enable_if_t<!std::is_void_v<repetition_t<T>>>>
+    : std::integral_constant<
+          std::size_t,
+          is_byte_set<typename repetition_t<T>::parser_t>::value
+              ? sum_steps(repetition_t<T>::count, 1)
+              : not_regular> {};
+
+template <class T>
+constexpr static inline bool is_composite_v =
+    is_plain_sequence_v<T> || is_plain_alternative_v<T> ||
+    !std::is_void_v<repetition_t<T>>;
+
+struct byte_set {
+  bool contains[alphabet_size]{};
+};
+
+struct step {
+  byte_set set{};
+  bool loop{};
+};
+
+template <class V, class T>
+constexpr void insert(byte_set& set) noexcept;
+
+template <class V, class... Ts>
+constexpr void insert_each(byte_set& set,
+                           [[maybe_unused]] type_list_t<Ts...> types) noexcept {
+  (insert<V, Ts>(set), ...);
+}
+
+template <class V, class T>
+constexpr void insert(byte_set& set) noexcept {
+  if constexpr (is_byte_predicate<T>::value) {
+    constexpr std::size_t size =
+        is_ascii_class_v<T> ? ascii_size : alphabet_size;
+    for (std::size_t i = 0; i < size; ++i) {
+      if (T{}(static_cast<V>(i))) {
+        set.contains[i] = true;
+      }
+    }
+  }
+  else {
+    insert_each<V>(set, dpsg::feed_t<T, type_list_t>{});
+  }
+}
+
+template <class V, class T, std::size_t N>
+constexpr void append_steps(step (&steps)[N], std::size_t& size) noexcept;
+
+template <class V, std::size_t N, class... Ts>
+constexpr void append_each(step (&steps)[N],
+                           std::size_t& size,
+                           [[maybe_unused]] type_list_t<Ts...> types) noexcept {
+  (append_steps<V, Ts>(steps, size), ...);
+}
+
+template <class V, class T, std::size_t N>
+constexpr void append_steps(step (&steps)[N], std::size_t& size) noexcept {
+  if constexpr (is_plain_sequence_v<T>) {
+    append_each<V>(steps, size, dpsg::feed_t<T, type_list_t>{});
+  }
+  else if constexpr (!std::is_void_v<repetition_t<T>>) {
+    using rep = repetition_t<T>;
+    byte_set set{};
+    insert<V, typename rep::parser_t>(set);
+    for (std::size_t i = 0; i < rep::count; ++i) {
+      steps[size++] = step{set, false};
+    }
+    steps[size++] = step{set, true};
+  }
+  else {
+    byte_set set{};
+    insert<V, T>(set);
+    steps[size++] = step{set, false};
+  }
+}
+
+template <class D, class V>
+struct builder {
+  constexpr static inline std::size_t size = step_count<D>::value;
+  // One state per step, one for the end of the chain and one dead state.
+  constexpr static inline std::size_t state_count = size + 2;
+  constexpr static inline std::size_t dead = state_count - 1;
+
+  struct nfa_steps {
+    step steps[size];
+  };
+
+  struct uncompressed {
+    std::uint8_t transitions[state_count][alphabet_size]{};
+    bool accepting[state_count]{};
+    std::uint8_t classes[alphabet_size]{};
+    std::size_t class_count{};
+    std::size_t partition[state_count]{};
+    std::size_t partition_count{};
+  };
+
+  [[nodiscard]] constexpr static nfa_steps make_steps() noexcept {
+    nfa_steps result{};
+    std::size_t n = 0;
+    append_steps<V, D>(result.steps, n);
+    return result;
+  }
+
+  // Steps are walked in order from the current one, a repetition taking
+  // priority over what follows it, which reproduces the possessive behaviour
+  // of the combinators.
+  [[nodiscard]] constexpr static std::size_t next_state(const nfa_steps& s,
+                                                        std::size_t state,
+                                                        std::size_t byte) {
+    for (std::size_t i = state; i < size; ++i) {
+      if (s.steps[i].set.contains[byte]) {
+        return s.steps[i].loop ? i : i + 1;
+      }
+      if (!s.steps[i].loop) {
+        return dead;
+      }
+    }
+    return dead;
+  }
+
+  [[nodiscard]] constexpr static bool is_accepting(const nfa_steps& s,
+                                                   std::size_t state) {
+    if (state == dead) {
+      return false;
+    }
+    for (std::size_t i = state; i < size; ++i) {
+      if (!s.steps[i].loop) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  [[nodiscard]] constexpr static uncompressed make_uncompressed() noexcept {
+    constexpr nfa_steps s = make_steps();
+    uncompressed u{};
+    for (std::size_t state = 0; state < state_count; ++state) {
+      u.accepting[state] = is_accepting(s, state);
+      for (std::size_t b = 0; b < alphabet_size; ++b) {
+        u.transitions[state][b] = static_cast<std::uint8_t>(
+            state == dead ? dead : next_state(s, state, b));
+      }
+    }
+
+    std::size_t representatives[alphabet_size]{};
+    for (std::size_t b = 0; b < alphabet_size; ++b) {
+      std::size_t c = 0;
+      for (; c < u.class_count; ++c) {
+        bool same = true;
+        for (std::size_t state = 0; state < state_count && same; ++state) {
+          same = u.transitions[state][b] ==
+                 u.transitions[state][representatives[c]];
+        }
+        if (same) {
+          break;
+        }
+      }
+      if (c == u.class_count) {
+        representatives[u.class_count++] = b;
+      }
+      u.classes[b] = static_cast<std::uint8_t>(c);
+    }
+
+    for (std::size_t state = 0; state < state_count; ++state) {
+      u.partition[state] = u.accepting[state] ? 1 : 0;
+    }
+    u.partition_count = 2;
+    for (;;) {
+      std::size_t refined[state_count]{};
+      std::size_t count = 0;
+      for (std::size_t state = 0; state < state_count; ++state) {
+        std::size_t other = 0;
+        for (; other < state; ++other) {
+          bool same = u.partition[other] == u.partition[state];
+          for (std::size_t c = 0; c < u.class_count && same; ++c) {
+            const auto b = representatives[c];
+            same = u.partition[u.transitions[other][b]] ==
+                   u.partition[u.transitions[state][b]];
+          }
+          if (same) {
+            break;
+          }
+        }
+        refined[state] = other == state ? count++ : refined[other];
+      }
+      for (std::size_t state = 0; state < state_count; ++state) {
+        u.partition[state] = refined[state];
+      }
+      if (count == u.partition_count) {
+        break;
+      }
+      u.partition_count = count;
+    }
+    return u;
+  }
+
+  constexpr static inline uncompressed table = make_uncompressed();
+};
+
+template <std::size_t States, std::size_t Classes>
+struct compressed_table {
+  std::uint8_t classes[alphabet_size]{};
+  std::uint8_t transitions[States][Classes]{};
+  bool accepting[States]{};
+  std::uint8_t start{};
+  std::uint8_t dead{};
+};
+}  // namespace detail
+
+template <class D>
+constexpr static inline bool is_regular_v =
+    detail::step_count<D>::value != detail::not_regular;
+
+template <class D, class V>
+struct automaton {
+  static_assert(is_regular_v<D>, "The description is not regular");
+  static_assert(sizeof(V) == 1, "Automata are built over bytes");
+
+ private:
+  using builder = detail::builder<D, V>;
+  constexpr static inline const auto& source = builder::table;
+
+ public:
+  constexpr static inline std::size_t state_count = source.partition_count;
+  constexpr static inline std::size_t class_count = source.class_count;
+
+  using table_t = detail::compressed_table<state_count, class_count>;
+
+ private:
+  [[nodiscard]] constexpr static table_t compress() noexcept {
+    table_t t{};
+    for (std::size_t b = 0; b < detail::alphabet_size; ++b) {
+      t.classes[b] = source.classes[b];
+    }
+    for (std::size_t state = 0; state < builder::state_count; ++state) {
+      const auto p = source.partition[state];
+      t.accepting[p] = source.accepting[state];
+      for (std::size_t b = 0; b < detail::alphabet_size; ++b) {
+        t.transitions[p][source.classes[b]] = static_cast<std::uint8_t>(
+            source.partition[source.transitions[state][b]]);
+      }
+    }
+    t.start = static_cast<std::uint8_t>(source.partition[0]);
+    t.dead = static_cast<std::uint8_t>(source.partition[builder::dead]);
+    return t;
+  }
+
+ public:
+  constexpr static inline table_t table = compress();
+
+  template <class ItB, class ItE>
+  [[nodiscard]] constexpr static ItB run(ItB begin, ItE end,
+                                         bool& accepted) noexcept {
+    auto state = table.start;
+    while (begin != end) {
+      const auto next =
+          table.transitions[state]
+                           [table.classes[static_cast<unsigned char>(*begin)]];
+      if (next == table.dead) {
+        break;
+      }
+      state = next;
+      ++begin;
+    }
+    accepted = table.accepting[state];
+    return begin;
+  }
+};
+
+namespace detail {
+template <class I, class D>
+constexpr static inline bool compiles_to_automaton_v =
+    ignores_structure<I>::value && is_composite_v<D> && is_regular_v<D>;
+
+template <class D, class I>
+struct automaton_parser {
+  I interpreter;
+
+  template <class ItB, class ItE>
+  [[nodiscard]] constexpr auto operator()(ItB begin, ItE end) const noexcept
+      -> customization_points::detail::result_t<I, ItB, D> {
+    using value_t = remove_cvref_t<decltype(*begin)>;
+    if constexpr (sizeof(value_t) == 1 && std::is_integral_v<value_t>) {
+      bool accepted = false;
+      auto it = automaton<D, value_t>::run(begin, end, accepted);
+      if (accepted) {
+        return customization_points::detail::success<I, D>(begin, it, end);
+      }
+      if constexpr (ignores_failure_position<I>::value) {
+        return customization_points::detail::failure<I, D>(begin, it, end);
+      }
+      else {
+        // The position of a failure depends on the shape of the description,
+        // which the automaton doesn't keep.
+        return combinators(begin, end);
+      }
+    }
+    else {
+      return combinators(begin, end);
+    }
+  }
+
+ private:
+  template <class ItB, class ItE>
+  [[nodiscard]] constexpr auto combinators(ItB begin, ItE end) const noexcept {
+    using customization_points::parsers_interpreters_make_parser;
+    return parsers_interpreters_make_parser(D{}, interpreter)(begin, end);
+  }
+};
+}  // namespace detail
+
+}  // namespace parsers::regular
+
+#endif  // GUARD_PARSERS_REGULAR_HPP
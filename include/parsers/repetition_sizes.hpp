@@ -0,0 +1,110 @@
+#ifndef GUARD_PARSERS_REPETITION_SIZES_HPP
+#define GUARD_PARSERS_REPETITION_SIZES_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace parsers {
+
+// Number of elements of each repetition (`many`, `many1`...) met while
+// parsing an input, in the order the repetitions started. A first pass over
+// the input records them and a second pass replays them to allocate the
+// results of the repetitions at their final size.
+class repetition_sizes {
+ public:
+  enum class mode { record, replay };
+
+  explicit repetition_sizes(mode m = mode::record) noexcept : _mode{m} {}
+
+  [[nodiscard]] mode current_mode() const noexcept { return _mode; }
+
+  // Starts over from the first size.
+  void replay() noexcept {
+    _mode = mode::replay;
+    _next = 0;
+  }
+
+  // Forgets the sizes but keeps their storage.
+  void record() noexcept {
+    _mode = mode::record;
+    _sizes.clear();
+    _next = 0;
+  }
+
+  [[nodiscard]] std::size_t size() const noexcept { return _sizes.size(); }
+
+  [[nodiscard]] std::uint32_t operator[](std::size_t i) const noexcept {
+    return _sizes[i];
+  }
+
+  // Called when a repetition starts. Returns the slot of the repetition while
+  // recording, and its size while replaying (0 once the sizes run out).
+  std::size_t begin() {
+    if (_mode == mode::record) {
+      _sizes.push_back(0);
+      return _sizes.size() - 1;
+    }
+    return _next < _sizes.size() ? _sizes[_next++] : 0;
+  }
+
+  void end(std::size_t slot, std::size_t count) noexcept {
+    if (_mode == mode::record) {
+      constexpr std::size_t max = std::numeric_limits<std::uint32_t>::max();
+      _sizes[slot] = static_cast<std::uint32_t>(count < max ? count : max);
+    }
+  }
+
+ private:
+  std::vector<std::uint32_t> _sizes;
+  std::size_t _next = 0;
+  mode _mode;
+};
+
+namespace detail {
+inline repetition_sizes*& current_repetition_sizes() noexcept {
+  thread_local repetition_sizes* current = nullptr;
+  return current;
+}
+
+// Callable from the constexpr object parser, during constant evaluation no
+// sizes are ever in use.
+#if defined(__cpp_lib_is_constant_evaluated)
+constexpr repetition_sizes* active_repetition_sizes() noexcept {
+  if (std::is_constant_evaluated()) {
+    return nullptr;
+  }
+  return current_repetition_sizes();
+}
+#else
+inline repetition_sizes* active_repetition_sizes() noexcept {
+  return current_repetition_sizes();
+}
+#endif
+}  // namespace detail
+
+// Makes `sizes` the one used by the parsers of the current thread for as long
+// as it lives.
+class use_repetition_sizes {
+ public:
+  explicit use_repetition_sizes(repetition_sizes& sizes) noexcept
+      : _enclosing{
+            std::exchange(detail::current_repetition_sizes(), &sizes)} {}
+
+  use_repetition_sizes(const use_repetition_sizes&) = delete;
+  use_repetition_sizes& operator=(const use_repetition_sizes&) = delete;
+
+  ~use_repetition_sizes() noexcept {
+    detail::current_repetition_sizes() = _enclosing;
+  }
+
+ private:
+  repetition_sizes* _enclosing;
+};
+
+}  // namespace parsers
+
+#endif  // GUARD_PARSERS_REPETITION_SIZES_HPP
@@ -70,13 +70,13 @@ struct result_traits<dpsg::result<std::pair<It, It>, F>> {
   template <class U,
             std::enable_if_t<std::is_same_v<type, std::decay_t<U>>, int> = 0>
   constexpr static inline value_type value(U&& result) noexcept {
-    return std::forward<U>(result).value();
+    return *std::forward<U>(result);
   }
 
   template <class U,
             std::enable_if_t<std::is_same_v<type, std::decay_t<U>>, int> = 0>
   constexpr static inline iterator_type next_iterator(U&& result) noexcept {
-    return std::get<1>(std::forward<U>(result).value());
+    return std::get<1>(*std::forward<U>(result));
   }
 
   template <class U,
@@ -102,13 +102,13 @@ struct result_traits<dpsg::result<std::pair<It, T>, F>> {
   template <class U,
             std::enable_if_t<std::is_same_v<type, std::decay_t<U>>, int> = 0>
   constexpr static inline value_type value(U&& result) noexcept {
-    return std::get<1>(std::forward<U>(result).value());
+    return std::get<1>(*std::forward<U>(result));
   }
 
   template <class U,
             std::enable_if_t<std::is_same_v<type, std::decay_t<U>>, int> = 0>
   constexpr static inline iterator_type next_iterator(U&& result) noexcept {
-    return std::get<0>(std::forward<U>(result).value());
+    return std::get<0>(*std::forward<U>(result));
   }
 
   template <class U,
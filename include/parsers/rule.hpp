@@ -0,0 +1,184 @@
+#ifndef GUARD_PARSERS_RULE_HPP
+#define GUARD_PARSERS_RULE_HPP
+
+#include "./description/rule.hpp"
+#include "./interpreters.hpp"
+#include "./utility.hpp"
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace parsers {
+
+// Hides a description behind one indirect call per interpreter, so that a
+// grammar can be split into rules compiled in different translation units.
+// Descriptions refer to a rule through `description::ref(rule)`, which also
+// allows a rule to refer to itself. A rule must outlive the descriptions
+// referring to it and is neither copied nor moved.
+// The parsers of the description are built once, by the constructor, and
+// shared by every call: as a prepared parser, a rule holding a `cached_bind`
+// can't be used from several threads. Only the matcher, the range_parser and
+// the object_parser are known to a rule, instrumented interpreters can't
+// look inside it.
+template <class It, class Result = empty>
+class rule {
+ public:
+  using iterator_t = It;
+  using result_type = Result;
+  using object_result_t = dpsg::result<std::pair<It, Result>, It>;
+  using range_result_t = interpreters::range_parser::result_t<It>;
+  using match_result_t = interpreters::matcher::result_t<It>;
+
+  constexpr static inline std::size_t buffer_size = 8 * sizeof(void*);
+
+  template <class D,
+            std::enable_if_t<!std::is_same_v<detail::remove_cvref_t<D>, rule>,
+                             int> = 0>
+  explicit rule(D&& desc)
+      : _vtable{&vtable_for<compiled<detail::remove_cvref_t<D>>>} {
+    using compiled_t = compiled<detail::remove_cvref_t<D>>;
+    if constexpr (is_small<compiled_t>) {
+      ::new (static_cast<void*>(_buffer)) compiled_t(desc);
+    }
+    else {
+      _heap = new compiled_t(desc);
+    }
+  }
+
+  rule(const rule&) = delete;
+  rule(rule&&) = delete;
+  rule& operator=(const rule&) = delete;
+  rule& operator=(rule&&) = delete;
+
+  ~rule() noexcept { _vtable->destroy(*this); }
+
+  template <class Interpreter, class ItB, class ItE>
+  [[nodiscard]] auto parse(ItB begin, ItE end) const {
+    static_assert(std::is_convertible_v<ItB, It> &&
+                      std::is_convertible_v<ItE, It>,
+                  "Rules only accept their own iterator type");
+    using interpreters::make_parser_t;
+    if constexpr (std::is_same_v<Interpreter,
+                                 make_parser_t<interpreters::object_parser>>) {
+      return _vtable->object(storage(), begin, end);
+    }
+    else if constexpr (std::is_same_v<
+                           Interpreter,
+                           make_parser_t<interpreters::range_parser>>) {
+      return _vtable->range(storage(), begin, end);
+    }
+    else {
+      // An interpreter deriving from one of these would silently run as its
+      // base inside the rule.
+      static_assert(
+          std::is_same_v<Interpreter, make_parser_t<interpreters::matcher>>,
+          "Rules can only be interpreted by the matcher, the range_parser or "
+          "the object_parser themselves");
+      return _vtable->match(storage(), begin, end);
+    }
+  }
+
+  [[nodiscard]] constexpr bool is_inline() const noexcept {
+    return _heap == nullptr;
+  }
+
+ private:
+  template <class D>
+  constexpr static inline bool is_small =
+      sizeof(D) <= buffer_size && alignof(D) <= alignof(std::max_align_t);
+
+  struct vtable_t {
+    void (*destroy)(rule&) noexcept;
+    match_result_t (*match)(const void*, It, It);
+    range_result_t (*range)(const void*, It, It);
+    object_result_t (*object)(const void*, It, It);
+  };
+
+  template <class D, class Interpreter>
+  using parser_t = decltype(interpreters::make_parser<Interpreter>(
+      std::declval<const D&>()));
+
+  // The parsers built for a description. Without a result, objects are
+  // built from the range_parser.
+  template <class D, bool Objects = !std::is_same_v<Result, empty>>
+  struct compiled {
+    explicit compiled(const D& desc)
+        : match{interpreters::make_parser<interpreters::matcher>(desc)},
+          range{interpreters::make_parser<interpreters::range_parser>(desc)} {}
+
+    parser_t<D, interpreters::matcher> match;
+    parser_t<D, interpreters::range_parser> range;
+  };
+
+  template <class D>
+  struct compiled<D, true> : compiled<D, false> {
+    explicit compiled(const D& desc)
+        : compiled<D, false>{desc},
+          object{interpreters::make_parser<interpreters::object_parser>(desc)} {
+    }
+
+    parser_t<D, interpreters::object_parser> object;
+  };
+
+  template <class C>
+  static void destroy(rule& r) noexcept {
+    if constexpr (is_small<C>) {
+      static_cast<C*>(static_cast<void*>(r._buffer))->~C();
+    }
+    else {
+      delete static_cast<C*>(r._heap);
+    }
+  }
+
+  template <class C>
+  static match_result_t match(const void* parsers, It begin, It end) {
+    return static_cast<const C*>(parsers)->match(begin, end);
+  }
+
+  template <class C>
+  static range_result_t range(const void* parsers, It begin, It end) {
+    return static_cast<const C*>(parsers)->range(begin, end);
+  }
+
+  template <class C>
+  static object_result_t object(const void* parsers, It begin, It end) {
+    if constexpr (std::is_same_v<Result, empty>) {
+      auto r = static_cast<const C*>(parsers)->range(begin, end);
+      if (r.has_value()) {
+        return object_result_t{dpsg::success(r.value().second, empty{})};
+      }
+      return object_result_t{dpsg::failure(r.error())};
+    }
+    else {
+      auto r = static_cast<const C*>(parsers)->object(begin, end);
+      if (r.has_value()) {
+        auto& [next, value] = r.value();
+        return object_result_t{
+            dpsg::success(next, static_cast<Result>(std::move(value)))};
+      }
+      return object_result_t{dpsg::failure(r.error())};
+    }
+  }
+
+  template <class C>
+  constexpr static inline vtable_t vtable_for{
+      &destroy<C>,
+      &match<C>,
+      &range<C>,
+      &object<C>,
+  };
+
+  [[nodiscard]] const void* storage() const noexcept {
+    return _heap != nullptr ? _heap : static_cast<const void*>(_buffer);
+  }
+
+  const vtable_t* _vtable;
+  void* _heap = nullptr;
+  alignas(std::max_align_t) unsigned char _buffer[buffer_size];
+};
+
+}  // namespace parsers
+
+#endif  // GUARD_PARSERS_RULE_HPP
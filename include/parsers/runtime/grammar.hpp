@@ -0,0 +1,757 @@
+#ifndef GUARD_PARSERS_RUNTIME_GRAMMAR_HPP
+#define GUARD_PARSERS_RUNTIME_GRAMMAR_HPP
+
+#include "../parsers.hpp"
+#include "../vm.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace parsers::runtime {
+
+struct load_error {
+  std::size_t position;
+  std::string message;
+};
+
+namespace detail {
+
+struct node {
+  enum class kind : std::uint8_t {
+    literal,
+    set,
+    reference,
+    sequence,
+    choice,
+    zero_or_more,
+    one_or_more,
+    optional,
+    and_predicate,
+    not_predicate,
+    capture,
+  };
+
+  kind type;
+  std::string text;
+  vm::program::set_t set;
+  std::vector<node> children;
+  const char* location = nullptr;
+  std::uint32_t index = 0;
+};
+
+struct rule {
+  node name;
+  node body;
+};
+
+template <class It>
+constexpr char unescape(It& it) noexcept {
+  switch (*it++) {
+    case 'n':
+      return '\n';
+    case 'r':
+      return '\r';
+    case 't':
+      return '\t';
+    case '0':
+      return '\0';
+    default:
+      return *std::prev(it);
+  }
+}
+
+template <class It>
+constexpr char next_character(It& it) noexcept {
+  if (*it == '\\') {
+    return unescape(++it);
+  }
+  return *it++;
+}
+
+struct make_reference {
+  template <class It>
+  node operator()(It begin, It end) const noexcept {
+    return node{
+        node::kind::reference, std::string{begin, end}, {}, {}, &*begin};
+  }
+};
+
+struct make_literal {
+  template <class It>
+  node operator()(It begin, It end) const noexcept {
+    node result{node::kind::literal};
+    for (++begin, --end; begin != end;) {
+      result.text.push_back(next_character(begin));
+    }
+    return result;
+  }
+};
+
+struct make_set {
+  template <class It>
+  node operator()(It begin, It end) const noexcept {
+    node result{node::kind::set};
+    ++begin;
+    --end;
+    const bool negated = begin != end && *begin == '^';
+    if (negated) {
+      ++begin;
+    }
+    while (begin != end) {
+      const auto low = static_cast<unsigned char>(next_character(begin));
+      auto high = low;
+      if (begin != end && *begin == '-' && std::next(begin) != end) {
+        high = static_cast<unsigned char>(next_character(++begin));
+      }
+      for (unsigned c = low; c <= high; ++c) {
+        result.set.set(c);
+      }
+    }
+    if (negated) {
+      result.set.flip();
+    }
+    return result;
+  }
+};
+
+struct make_any {
+  template <class It>
+  node operator()([[maybe_unused]] It begin,
+                  [[maybe_unused]] It end) const noexcept {
+    node result{node::kind::set};
+    result.set.set();
+    return result;
+  }
+};
+
+struct first_character {
+  template <class It>
+  char operator()(It begin, [[maybe_unused]] It end) const noexcept {
+    return *begin;
+  }
+};
+
+struct make_capture {
+  node operator()(node&& inner) const noexcept {
+    return node{node::kind::capture, {}, {}, {std::move(inner)}};
+  }
+};
+
+struct apply_suffixes {
+  template <class T>
+  node operator()(T&& pair) const noexcept {
+    auto result = std::get<0>(std::forward<T>(pair));
+    for (const char suffix : std::get<1>(pair)) {
+      const auto type = suffix == '*'   ? node::kind::zero_or_more
+                        : suffix == '+' ? node::kind::one_or_more
+                                        : node::kind::optional;
+      result = node{type, {}, {}, {std::move(result)}};
+    }
+    return result;
+  }
+};
+
+struct apply_prefixes {
+  template <class T>
+  node operator()(T&& pair) const noexcept {
+    auto result = std::get<1>(std::forward<T>(pair));
+    const auto& prefixes = std::get<0>(pair);
+    for (auto it = prefixes.rbegin(); it != prefixes.rend(); ++it) {
+      const auto type =
+          *it == '&' ? node::kind::and_predicate : node::kind::not_predicate;
+      result = node{type, {}, {}, {std::move(result)}};
+    }
+    return result;
+  }
+};
+
+struct make_sequence {
+  template <class C>
+  node operator()(C&& elements) const noexcept {
+    if (elements.size() == 1) {
+      return std::move(elements.front());
+    }
+    return node{node::kind::sequence,
+                {},
+                {},
+                {std::make_move_iterator(elements.begin()),
+                 std::make_move_iterator(elements.end())}};
+  }
+};
+
+struct make_choice {
+  template <class T>
+  node operator()(T&& pair) const noexcept {
+    auto& rest = std::get<1>(pair);
+    if (rest.empty()) {
+      return std::get<0>(std::forward<T>(pair));
+    }
+    node result{node::kind::choice};
+    result.children.push_back(std::get<0>(std::forward<T>(pair)));
+    result.children.insert(result.children.end(),
+                           std::make_move_iterator(rest.begin()),
+                           std::make_move_iterator(rest.end()));
+    return result;
+  }
+};
+
+struct make_rule {
+  template <class T>
+  rule operator()(T&& pair) const noexcept {
+    return rule{std::get<0>(std::forward<T>(pair)),
+                std::get<1>(std::forward<T>(pair))};
+  }
+};
+
+template <char... Cs>
+struct is_none_of {
+  template <class C>
+  constexpr bool operator()(C c) const noexcept {
+    return ((c != Cs) && ...);
+  }
+};
+
+namespace syntax {
+using namespace ::parsers::description;
+
+template <char C>
+using ch = character<C>;
+template <char... Cs>
+using none_of = ascii::character_class<is_none_of<Cs...>>;
+
+using comment = sequence<ch<'#'>, many<none_of<'\n'>>>;
+using spacing = discard<many<either<ascii::space_t, comment>>>;
+template <class T>
+using token = sequence<T, spacing>;
+template <char C>
+using punctuation = discard<token<ch<C>>>;
+
+using identifier = sequence<either<ascii::alpha_t, ch<'_'>>,
+                            many<either<ascii::alnum_t, ch<'_'>>>>;
+template <char Q>
+using quoted = sequence<ch<Q>,
+                        many<either<sequence<ch<'\\'>, any_t>, none_of<Q>>>,
+                        ch<Q>>;
+using literal = either<quoted<'\''>, quoted<'"'>>;
+using set = sequence<ch<'['>,
+                     many<either<sequence<ch<'\\'>, any_t>, none_of<']'>>>,
+                     ch<']'>>;
+using arrow = token<alternative<sequence<ch<'<'>, ch<'-'>>,
+                                sequence<ch<':'>, ch<':'>, ch<'='>>,
+                                ch<'='>>>;
+
+// A rule ends where the next one starts: a name followed by an arrow.
+struct not_definition : guard<not_definition> {
+  template <class It, class End>
+  constexpr bool operator()(It begin, End end) const noexcept {
+    const auto matcher =
+        interpreters::make_parser<interpreters::matcher>(arrow{});
+    return !matcher(begin, end).has_value();
+  }
+};
+
+struct expression;
+
+using primary = choose<
+    sequence<token<build<identifier, make_reference>>, not_definition>,
+    sequence<punctuation<'('>, expression, punctuation<')'>>,
+    map<sequence<punctuation<'{'>, expression, punctuation<'}'>>,
+        make_capture>,
+    token<build<literal, make_literal>>,
+    token<build<set, make_set>>,
+    token<build<ch<'.'>, make_any>>>;
+template <char... Cs>
+using operators = many<token<build<alternative<ch<Cs>...>, first_character>>>;
+using suffix = map<both<primary, operators<'*', '+', '?'>>, apply_suffixes>;
+using prefix = map<both<operators<'&', '!'>, suffix>, apply_prefixes>;
+using branch = map<many<prefix>, make_sequence>;
+using choice =
+    map<both<branch,
+             many<sequence<discard<token<either<ch<'/'>, ch<'|'>>>>,
+                           branch>>>,
+        make_choice>;
+
+struct expression : cast<node, recursive<choice>> {};
+
+using definition =
+    map<sequence<token<build<identifier, make_reference>>,
+                 discard<arrow>,
+                 expression,
+                 discard<optional<token<ch<';'>>>>>,
+        make_rule>;
+using grammar = sequence<spacing, many1<definition>, end_t>;
+}  // namespace syntax
+
+class compiler {
+ public:
+  compiler(vm::program& p, std::string_view text) noexcept
+      : _program{p}, _text{text} {}
+
+  std::optional<load_error> compile(std::vector<rule>& rules) {
+    _rules = &rules;
+    for (std::size_t i = 0; i < rules.size(); ++i) {
+      for (std::size_t j = 0; j < i; ++j) {
+        if (rules[j].name.text == rules[i].name.text) {
+          return error(rules[i].name,
+                       "rule '" + rules[i].name.text + "' is defined twice");
+        }
+      }
+    }
+    for (auto& r : rules) {
+      if (auto e = resolve(r.body)) {
+        return e;
+      }
+    }
+
+    _nullable.assign(rules.size(), false);
+    for (bool changed = true; changed;) {
+      changed = false;
+      for (std::size_t i = 0; i < rules.size(); ++i) {
+        if (!_nullable[i] && nullable(rules[i].body)) {
+          _nullable[i] = changed = true;
+        }
+      }
+    }
+    for (std::size_t i = 0; i < rules.size(); ++i) {
+      if (!check_repetitions(rules[i].body)) {
+        return error(rules[i].name,
+                     "rule '" + rules[i].name.text +
+                         "' repeats an expression matching the empty input");
+      }
+      std::vector<bool> visiting(rules.size(), false);
+      if (left_recursive(i, visiting)) {
+        return error(rules[i].name,
+                     "rule '" + rules[i].name.text + "' is left recursive");
+      }
+    }
+
+    const auto& start = rules.front().body;
+    if (start.type == node::kind::sequence) {
+      for (const auto& element : start.children) {
+        _program.emit(vm::opcode::checkpoint);
+        emit(element);
+      }
+    }
+    else {
+      emit(start);
+    }
+    _program.emit(vm::opcode::end);
+
+    std::vector<std::uint32_t> addresses;
+    for (const auto& r : rules) {
+      addresses.push_back(_program.here());
+      emit(r.body);
+      _program.emit(vm::opcode::ret);
+    }
+    for (const auto& [call, index] : _calls) {
+      _program.patch(call, addresses[index]);
+    }
+    return std::nullopt;
+  }
+
+ private:
+  load_error error(const node& n, std::string message) const {
+    return load_error{static_cast<std::size_t>(n.location - _text.data()),
+                      std::move(message)};
+  }
+
+  std::optional<load_error> resolve(node& n) {
+    if (n.type == node::kind::reference) {
+      const auto& rules = *_rules;
+      for (std::size_t i = 0; i < rules.size(); ++i) {
+        if (rules[i].name.text == n.text) {
+          n.index = static_cast<std::uint32_t>(i);
+          return std::nullopt;
+        }
+      }
+      return error(n, "undefined rule '" + n.text + "'");
+    }
+    if (n.type == node::kind::capture) {
+      n.index = _program.add_capture();
+    }
+    for (auto& child : n.children) {
+      if (auto e = resolve(child)) {
+        return e;
+      }
+    }
+    return std::nullopt;
+  }
+
+  bool nullable(const node& n) const {
+    switch (n.type) {
+      case node::kind::literal:
+        return n.text.empty();
+      case node::kind::set:
+        return false;
+      case node::kind::reference:
+        return _nullable[n.index];
+      case node::kind::sequence:
+        return std::all_of(n.children.begin(),
+                           n.children.end(),
+                           [this](const node& c) { return nullable(c); });
+      case node::kind::choice:
+        return std::any_of(n.children.begin(),
+                           n.children.end(),
+                           [this](const node& c) { return nullable(c); });
+      case node::kind::one_or_more:
+      case node::kind::capture:
+        return nullable(n.children.front());
+      default:
+        return true;
+    }
+  }
+
+  bool check_repetitions(const node& n) const {
+    if ((n.type == node::kind::zero_or_more ||
+         n.type == node::kind::one_or_more) &&
+        nullable(n.children.front())) {
+      return false;
+    }
+    return std::all_of(n.children.begin(),
+                       n.children.end(),
+                       [this](const node& c) { return check_repetitions(c); });
+  }
+
+  // Calls the visitor with every rule the node may invoke before consuming
+  // any input.
+  template <class F>
+  void leftmost(const node& n, F&& visit) const {
+    if (n.type == node::kind::reference) {
+      visit(n.index);
+    }
+    else if (n.type == node::kind::sequence) {
+      for (const auto& child : n.children) {
+        leftmost(child, visit);
+        if (!nullable(child)) {
+          break;
+        }
+      }
+    }
+    else {
+      for (const auto& child : n.children) {
+        leftmost(child, visit);
+      }
+    }
+  }
+
+  bool left_recursive(std::size_t index, std::vector<bool>& visiting) const {
+    if (visiting[index]) {
+      return true;
+    }
+    visiting[index] = true;
+    bool result = false;
+    leftmost((*_rules)[index].body, [&](std::size_t next) {
+      result = result || left_recursive(next, visiting);
+    });
+    visiting[index] = false;
+    return result;
+  }
+
+  // Computes the bytes a node must start with, if it can't succeed without
+  // consuming one of them.
+  bool first_set(const node& n, vm::program::set_t& set) const {
+    switch (n.type) {
+      case node::kind::literal:
+        if (n.text.empty()) {
+          return false;
+        }
+        set.set(static_cast<unsigned char>(n.text.front()));
+        return true;
+      case node::kind::set:
+        set |= n.set;
+        return true;
+      case node::kind::reference:
+        return first_set((*_rules)[n.index].body, set);
+      case node::kind::sequence:
+        for (const auto& child : n.children) {
+          if (!nullable(child)) {
+            return first_set(child, set);
+          }
+          if (!first_set_of_nullable(child, set)) {
+            return false;
+          }
+        }
+        return false;
+      case node::kind::choice:
+        return std::all_of(
+            n.children.begin(), n.children.end(), [&](const node& c) {
+              return first_set(c, set);
+            });
+      case node::kind::one_or_more:
+      case node::kind::capture:
+        return first_set(n.children.front(), set);
+      default:
+        return false;
+    }
+  }
+
+  // A nullable prefix only narrows the first bytes if it consumes at most
+  // optional bytes of a known set.
+  bool first_set_of_nullable(const node& n, vm::program::set_t& set) const {
+    switch (n.type) {
+      case node::kind::zero_or_more:
+      case node::kind::optional:
+        return first_set(n.children.front(), set);
+      default:
+        return false;
+    }
+  }
+
+  static bool is_byte(const node& n) noexcept {
+    return n.type == node::kind::set ||
+           (n.type == node::kind::literal && n.text.size() == 1);
+  }
+
+  static vm::program::set_t byte_set(const node& n) noexcept {
+    if (n.type == node::kind::set) {
+      return n.set;
+    }
+    vm::program::set_t set;
+    set.set(static_cast<unsigned char>(n.text.front()));
+    return set;
+  }
+
+  void emit_set(const vm::program::set_t& set) {
+    if (set.all()) {
+      _program.emit(vm::opcode::any);
+    }
+    else if (set.count() == 1) {
+      for (std::size_t i = 0; i < set.size(); ++i) {
+        if (set[i]) {
+          _program.emit(vm::opcode::character, static_cast<std::uint32_t>(i));
+        }
+      }
+    }
+    else {
+      _program.emit(vm::opcode::set, _program.add_set(set));
+    }
+  }
+
+  void emit(const node& n) {
+    switch (n.type) {
+      case node::kind::literal:
+        if (n.text.size() == 1) {
+          emit_set(byte_set(n));
+        }
+        else if (!n.text.empty()) {
+          _program.emit(vm::opcode::string, _program.add_string(n.text));
+        }
+        break;
+      case node::kind::set:
+        emit_set(n.set);
+        break;
+      case node::kind::reference:
+        _calls.emplace_back(_program.emit(vm::opcode::call), n.index);
+        break;
+      case node::kind::sequence:
+        for (const auto& child : n.children) {
+          emit(child);
+        }
+        break;
+      case node::kind::choice:
+        emit_choice(n.children);
+        break;
+      case node::kind::one_or_more:
+        emit(n.children.front());
+        [[fallthrough]];
+      case node::kind::zero_or_more:
+        emit_repetition(n.children.front());
+        break;
+      case node::kind::optional: {
+        const auto choice = _program.emit(vm::opcode::choice);
+        emit(n.children.front());
+        const auto commit = _program.emit(vm::opcode::commit);
+        _program.patch(choice, _program.here());
+        _program.patch(commit, _program.here());
+        break;
+      }
+      case node::kind::and_predicate: {
+        const auto choice = _program.emit(vm::opcode::choice);
+        emit(n.children.front());
+        const auto commit = _program.emit(vm::opcode::back_commit);
+        _program.patch(choice, _program.emit(vm::opcode::fail));
+        _program.patch(commit, _program.here());
+        break;
+      }
+      case node::kind::not_predicate: {
+        const auto choice = _program.emit(vm::opcode::choice);
+        emit(n.children.front());
+        _program.emit(vm::opcode::fail_twice);
+        _program.patch(choice, _program.here());
+        break;
+      }
+      case node::kind::capture:
+        _program.emit(vm::opcode::open_capture, n.index);
+        emit(n.children.front());
+        _program.emit(vm::opcode::close_capture, n.index);
+        break;
+    }
+  }
+
+  void emit_repetition(const node& element) {
+    if (element.type == node::kind::set) {
+      _program.emit(vm::opcode::span, _program.add_set(element.set));
+      return;
+    }
+    const auto choice = _program.emit(vm::opcode::choice);
+    const auto loop = _program.here();
+    emit(element);
+    _program.emit(vm::opcode::partial_commit, loop);
+    _program.patch(choice, _program.here());
+  }
+
+  // Runs of single bytes are merged into a set and runs of literals into a
+  // trie, both of which pick a branch without backtracking.
+  void emit_choice(const std::vector<node>& branches) {
+    std::vector<node> merged;
+    for (std::size_t i = 0; i < branches.size();) {
+      std::size_t bytes = i;
+      while (bytes < branches.size() && is_byte(branches[bytes])) {
+        ++bytes;
+      }
+      std::size_t literals = i;
+      while (literals < branches.size() &&
+             branches[literals].type == node::kind::literal) {
+        ++literals;
+      }
+      if (bytes - i > 1 && bytes >= literals) {
+        node set{node::kind::set};
+        for (; i < bytes; ++i) {
+          set.set |= byte_set(branches[i]);
+        }
+        merged.push_back(std::move(set));
+      }
+      else if (literals - i > 1) {
+        node trie{node::kind::literal};
+        for (; i < literals; ++i) {
+          trie.children.push_back(branches[i]);
+        }
+        merged.push_back(std::move(trie));
+      }
+      else {
+        merged.push_back(branches[i++]);
+      }
+    }
+
+    std::vector<std::uint32_t> commits;
+    for (std::size_t i = 0; i < merged.size(); ++i) {
+      const auto& branch = merged[i];
+      if (i + 1 == merged.size()) {
+        emit_branch(branch);
+        break;
+      }
+      std::optional<std::uint32_t> skip;
+      if (vm::program::set_t set; branch_first_set(branch, set)) {
+        _program.emit(vm::opcode::test_set, _program.add_set(set));
+        skip = _program.emit(vm::opcode::jump);
+      }
+      const auto choice = _program.emit(vm::opcode::choice);
+      emit_branch(branch);
+      commits.push_back(_program.emit(vm::opcode::commit));
+      _program.patch(choice, _program.here());
+      if (skip) {
+        _program.patch(*skip, _program.here());
+      }
+    }
+    for (auto commit : commits) {
+      _program.patch(commit, _program.here());
+    }
+  }
+
+  bool is_trie(const node& n) const noexcept {
+    return n.type == node::kind::literal && !n.children.empty();
+  }
+
+  void emit_branch(const node& branch) {
+    if (!is_trie(branch)) {
+      emit(branch);
+      return;
+    }
+    std::vector<std::string_view> literals;
+    for (const auto& literal : branch.children) {
+      literals.push_back(literal.text);
+    }
+    _program.emit(vm::opcode::trie, _program.add_trie(literals));
+  }
+
+  bool branch_first_set(const node& branch, vm::program::set_t& set) const {
+    if (!is_trie(branch)) {
+      return first_set(branch, set);
+    }
+    return std::all_of(
+        branch.children.begin(), branch.children.end(), [&](const node& c) {
+          return first_set(c, set);
+        });
+  }
+
+  vm::program& _program;
+  std::string_view _text;
+  std::vector<rule>* _rules = nullptr;
+  std::vector<bool> _nullable;
+  std::vector<std::pair<std::uint32_t, std::uint32_t>> _calls;
+};
+
+}  // namespace detail
+
+class grammar {
+ public:
+  template <class It>
+  using result_t = vm::program::result_t<It>;
+  template <class It>
+  using captures_t = vm::program::captures_t<It>;
+
+  // Rules are written `name <- expression`, the first one being the start
+  // rule. Expressions are built from 'literals', "literals", [classes], `.`,
+  // references to other rules, (groups) and {captures}, combined with
+  // sequences, ordered choices (`/` or `|`), the `*`, `+` and `?` suffixes
+  // and the `&` and `!` predicates. `#` starts a comment.
+  [[nodiscard]] static dpsg::result<grammar, load_error> load(
+      std::string_view text) {
+    using result = dpsg::result<grammar, load_error>;
+    auto rules = parsers::parse(detail::syntax::grammar{}, text);
+    if (!rules.has_value()) {
+      return result{dpsg::in_place_error,
+                    static_cast<std::size_t>(rules.error() - text.begin()),
+                    "syntax error"};
+    }
+    grammar g;
+    detail::compiler c{g._program, text};
+    if (auto e = c.compile(rules.value())) {
+      return result{dpsg::in_place_error, std::move(*e)};
+    }
+    return result{dpsg::in_place_success, std::move(g)};
+  }
+
+  template <class ItB, class ItE>
+  [[nodiscard]] result_t<ItB> operator()(ItB begin, ItE end) const {
+    return _program(begin, end);
+  }
+
+  template <class ItB, class ItE>
+  [[nodiscard]] result_t<ItB> operator()(ItB begin,
+                                         ItE end,
+                                         captures_t<ItB>& captures) const {
+    return _program(begin, end, captures);
+  }
+
+  [[nodiscard]] const vm::program& program() const noexcept {
+    return _program;
+  }
+
+  [[nodiscard]] std::size_t capture_count() const noexcept {
+    return _program.capture_count();
+  }
+
+ private:
+  vm::program _program;
+};
+
+}  // namespace parsers::runtime
+
+#endif  // GUARD_PARSERS_RUNTIME_GRAMMAR_HPP
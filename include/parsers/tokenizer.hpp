@@ -0,0 +1,231 @@
+#ifndef GUARD_PARSERS_TOKENIZER_HPP
+#define GUARD_PARSERS_TOKENIZER_HPP
+
+#include "./interpreters.hpp"
+#include "./regular.hpp"
+#include "./utility.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace parsers {
+
+// Tokens compare equal to their kind, so that `character<kind>` and the
+// other character predicates can be used to parse a sequence of tokens.
+template <class Kind>
+struct token {
+  using kind_t = Kind;
+
+  Kind kind;
+  std::uint32_t offset;
+  std::uint32_t length;
+
+  template <class CharT>
+  [[nodiscard]] constexpr std::basic_string_view<CharT> text(
+      std::basic_string_view<CharT> input) const noexcept {
+    return input.substr(offset, length);
+  }
+
+  [[nodiscard]] friend constexpr bool operator==(const token& t,
+                                                 Kind k) noexcept {
+    return t.kind == k;
+  }
+  [[nodiscard]] friend constexpr bool operator==(Kind k,
+                                                 const token& t) noexcept {
+    return t.kind == k;
+  }
+  [[nodiscard]] friend constexpr bool operator!=(const token& t,
+                                                 Kind k) noexcept {
+    return t.kind != k;
+  }
+  [[nodiscard]] friend constexpr bool operator!=(Kind k,
+                                                 const token& t) noexcept {
+    return t.kind != k;
+  }
+};
+
+namespace detail {
+using namespace ::parsers::detail;
+
+template <class T>
+constexpr std::true_type is_single_character_f(
+    const description::satisfy_character<T>&) noexcept;
+constexpr std::false_type is_single_character_f(...) noexcept;
+
+// Marks the bytes a description may start with, or every byte if that
+// can't be told.
+template <class D>
+constexpr void first_bytes(const D& desc, std::uint64_t (&table)[256],
+                           std::uint64_t bit) noexcept {
+  using namespace description;
+  if constexpr (regular::is_regular_v<D>) {
+    using table_t = decltype(regular::automaton<D, char>::table);
+    const table_t& automaton = regular::automaton<D, char>::table;
+    for (std::size_t b = 0; b < 256; ++b) {
+      if (automaton.transitions[automaton.start][automaton.classes[b]] !=
+          automaton.dead) {
+        table[b] |= bit;
+      }
+    }
+  }
+  else if constexpr (dpsg::is_template_instance_v<D, static_string>) {
+    if (desc.begin() != desc.end()) {
+      table[static_cast<unsigned char>(*desc.begin())] |= bit;
+    }
+  }
+  else if constexpr (decltype(is_single_character_f(desc))::value) {
+    for (std::size_t b = 0; b < 256; ++b) {
+      if (desc(static_cast<char>(b))) {
+        table[b] |= bit;
+      }
+    }
+  }
+  else {
+    for (auto& entry : table) {
+      entry |= bit;
+    }
+  }
+}
+}  // namespace detail
+
+template <class Kind, class Description>
+struct lexeme {
+  Kind kind;
+  Description description;
+};
+template <class K, class D>
+lexeme(K, D) -> lexeme<K, D>;
+
+// Splits an input into tokens once, so that backtracking in the parser
+// costs token indices instead of character rescans. At each position the
+// `skip` description is matched first, then the longest lexeme wins, the
+// first one declared winning ties. Lexemes are matched with the matcher,
+// and thus run as automata whenever they are regular. Over bytes, only the
+// lexemes that may start with the current byte are tried.
+template <class Skip, class... Lexemes>
+class tokenizer {
+  static_assert(sizeof...(Lexemes) > 0, "A tokenizer needs lexemes");
+  static_assert(sizeof...(Lexemes) <= 64, "A tokenizer has 64 lexemes at most");
+
+ public:
+  using kind_t = std::common_type_t<decltype(Lexemes::kind)...>;
+  using token_t = token<kind_t>;
+
+  constexpr explicit tokenizer(Skip skip, Lexemes... lexemes) noexcept
+      : _skip{std::move(skip)}, _lexemes{std::move(lexemes)...} {
+    fill_dispatch(std::index_sequence_for<Lexemes...>{});
+  }
+
+  // Fails with the offset of the first character no lexeme recognizes.
+  template <class T>
+  [[nodiscard]] dpsg::result<std::vector<token_t>, std::size_t> operator()(
+      const T& input) const {
+    using std::begin;
+    using std::end;
+    std::vector<token_t> tokens;
+    tokens.reserve(std::size(input) / 4);
+    if (auto offset = tokenize(begin(input), end(input), tokens)) {
+      return dpsg::result<std::vector<token_t>, std::size_t>{
+          dpsg::in_place_error, *offset};
+    }
+    return dpsg::result<std::vector<token_t>, std::size_t>{
+        dpsg::in_place_success, std::move(tokens)};
+  }
+
+  template <class ItB, class ItE>
+  std::optional<std::size_t> tokenize(ItB begin,
+                                      ItE end,
+                                      std::vector<token_t>& tokens) const {
+    const auto skip = interpreters::make_parser<interpreters::matcher>(_skip);
+    auto current = begin;
+    for (;;) {
+      if (auto skipped = skip(current, end)) {
+        current = *skipped;
+      }
+      if (current == end) {
+        return std::nullopt;
+      }
+      auto longest = current;
+      kind_t kind{};
+      longest_match(current, end, longest, kind);
+      if (longest == current) {
+        return static_cast<std::size_t>(std::distance(begin, current));
+      }
+      tokens.push_back(token_t{
+          kind,
+          static_cast<std::uint32_t>(std::distance(begin, current)),
+          static_cast<std::uint32_t>(std::distance(current, longest))});
+      current = longest;
+    }
+  }
+
+ private:
+  template <std::size_t... Is>
+  constexpr void fill_dispatch(
+      [[maybe_unused]] std::index_sequence<Is...>) noexcept {
+    (detail::first_bytes(std::get<Is>(_lexemes).description,
+                         _dispatch,
+                         std::uint64_t{1} << Is),
+     ...);
+  }
+
+  template <class ItB, class ItE>
+  void longest_match(ItB current, ItE end, ItB& longest, kind_t& kind) const {
+    using value_t = detail::remove_cvref_t<decltype(*current)>;
+    std::uint64_t candidates = ~std::uint64_t{0};
+    if constexpr (sizeof(value_t) == 1) {
+      candidates = _dispatch[static_cast<unsigned char>(*current)];
+    }
+    match_each(current,
+               end,
+               longest,
+               kind,
+               candidates,
+               std::index_sequence_for<Lexemes...>{});
+  }
+
+  template <class ItB, class ItE, std::size_t... Is>
+  void match_each(ItB current,
+                  ItE end,
+                  ItB& longest,
+                  kind_t& kind,
+                  std::uint64_t candidates,
+                  [[maybe_unused]] std::index_sequence<Is...>) const {
+    ((candidates & (std::uint64_t{1} << Is)
+          ? match_one(std::get<Is>(_lexemes), current, end, longest, kind)
+          : void()),
+     ...);
+  }
+
+  template <class L, class ItB, class ItE>
+  static void match_one(const L& lexeme,
+                        ItB current,
+                        ItE end,
+                        ItB& longest,
+                        kind_t& kind) {
+    const auto parser =
+        interpreters::make_parser<interpreters::matcher>(lexeme.description);
+    if (auto r = parser(current, end);
+        r && std::distance(current, *r) > std::distance(current, longest)) {
+      longest = *r;
+      kind = lexeme.kind;
+    }
+  }
+
+  Skip _skip;
+  std::tuple<Lexemes...> _lexemes;
+  std::uint64_t _dispatch[256]{};
+};
+template <class S, class... Ls>
+tokenizer(S, Ls...) -> tokenizer<S, Ls...>;
+
+}  // namespace parsers
+
+#endif  // GUARD_PARSERS_TOKENIZER_HPP
@@ -0,0 +1,230 @@
+#ifndef GUARD_PARSERS_TRACING_HPP
+#define GUARD_PARSERS_TRACING_HPP
+
+#include "./interpreters.hpp"
+#include "./profiling.hpp"
+#include "./result_traits.hpp"
+#include "./utility.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace parsers {
+
+// Begin and end events of every parser call, collected by the `tracing`
+// interpreter into a ring buffer allocated once: when it is full, the oldest
+// events are overwritten. Offsets count the elements from the beginning of
+// the outermost call.
+class trace {
+ public:
+  struct event {
+    std::string_view name;
+    std::chrono::nanoseconds timestamp;
+    std::uint64_t offset;
+    bool begin;
+    bool success;
+  };
+
+  explicit trace(std::size_t capacity = std::size_t{1} << 16)
+      : _events(capacity == 0 ? 1 : capacity) {}
+
+  [[nodiscard]] std::size_t capacity() const noexcept {
+    return _events.size();
+  }
+
+  [[nodiscard]] std::size_t size() const noexcept {
+    return _written < _events.size() ? static_cast<std::size_t>(_written)
+                                     : _events.size();
+  }
+
+  [[nodiscard]] std::uint64_t dropped() const noexcept {
+    return _written - size();
+  }
+
+  // The i-th oldest event still in the buffer.
+  [[nodiscard]] const event& operator[](std::size_t i) const noexcept {
+    return _events[(dropped() + i) % _events.size()];
+  }
+
+  void clear() noexcept {
+    _written = 0;
+    _depth = 0;
+    _start = clock::now();
+  }
+
+  // Chrome trace event format, as read by chrome://tracing and Perfetto.
+  // End events whose begin event was overwritten are left out.
+  [[nodiscard]] std::string chrome_json() const {
+    std::string out = "{\"traceEvents\": [";
+    std::size_t open = 0;
+    bool first = true;
+    for (std::size_t i = 0; i < size(); ++i) {
+      const auto& e = (*this)[i];
+      if (!e.begin) {
+        if (open == 0) {
+          continue;
+        }
+        --open;
+      }
+      else {
+        ++open;
+      }
+      out += first ? "\n" : ",\n";
+      first = false;
+      out += "  {\"name\": \"";
+      detail::escape_json(out, detail::short_type_name(e.name));
+      out += e.begin ? "\", \"ph\": \"B\"" : "\", \"ph\": \"E\"";
+      out += ", \"ts\": ";
+      append_microseconds(out, e.timestamp);
+      out += ", \"pid\": 0, \"tid\": 0, \"args\": {\"offset\": " +
+             std::to_string(e.offset);
+      if (e.begin) {
+        out += ", \"type\": \"";
+        detail::escape_json(out, e.name);
+        out += '"';
+      }
+      else {
+        out += e.success ? ", \"success\": true" : ", \"success\": false";
+      }
+      out += "}}";
+    }
+    out += "\n], \"displayTimeUnit\": \"ns\"}\n";
+    return out;
+  }
+
+  // Returns the offset of the call, `remaining` being the distance from its
+  // beginning to the end of the input.
+  std::uint64_t begin(std::string_view name, std::uint64_t remaining) noexcept {
+    if (_depth++ == 0) {
+      _length = remaining;
+    }
+    const auto offset = _length - remaining;
+    record(event{name, elapsed(), offset, true, false});
+    return offset;
+  }
+
+  void end(std::string_view name,
+           std::uint64_t offset,
+           bool success) noexcept {
+    record(event{name, elapsed(), offset, false, success});
+    --_depth;
+  }
+
+  [[nodiscard]] std::uint64_t length() const noexcept { return _length; }
+
+ private:
+  using clock = std::chrono::steady_clock;
+
+  [[nodiscard]] std::chrono::nanoseconds elapsed() const noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() -
+                                                                _start);
+  }
+
+  void record(const event& e) noexcept {
+    _events[_written % _events.size()] = e;
+    ++_written;
+  }
+
+  static void append_microseconds(std::string& out,
+                                  std::chrono::nanoseconds time) {
+    const auto ns = time.count();
+    const auto fraction = std::to_string(1000 + ns % 1000);
+    out += std::to_string(ns / 1000);
+    out += '.';
+    out.append(fraction, 1, 3);
+  }
+
+  std::vector<event> _events;
+  std::uint64_t _written = 0;
+  std::uint64_t _depth = 0;
+  std::uint64_t _length = 0;
+  clock::time_point _start = clock::now();
+};
+
+namespace detail {
+template <class P>
+struct traced_parser {
+  P parser;
+  trace* target;
+  std::string_view name;
+
+  template <class ItB, class ItE>
+  auto operator()(ItB begin, ItE end) const -> decltype(parser(begin, end)) {
+    const auto offset = target->begin(name, remaining(begin, end));
+    auto result = parser(begin, end);
+    if (has_value(result)) {
+      target->end(name,
+                  target->length() - remaining(next_iterator(result), end),
+                  true);
+    }
+    else if constexpr (std::is_convertible_v<
+                           typename result_traits<decltype(result)>::
+                               failure_type,
+                           ItB>) {
+      target->end(name,
+                  target->length() -
+                      remaining(static_cast<ItB>(result.error()), end),
+                  false);
+    }
+    else {
+      target->end(name, offset, false);
+    }
+    return result;
+  }
+
+ private:
+  template <class ItB, class ItE>
+  static std::uint64_t remaining([[maybe_unused]] ItB begin,
+                                 [[maybe_unused]] ItE end) noexcept {
+    if constexpr (std::is_same_v<ItB, ItE>) {
+      return static_cast<std::uint64_t>(std::distance(begin, end));
+    }
+    else {
+      return 0;
+    }
+  }
+};
+}  // namespace detail
+
+// Wraps an interpreter so that each parser it builds records its calls in a
+// `trace`. Descriptions run by an automaton appear as a single call. With
+// `Enabled` false, nothing is recorded and the parsers are those of
+// `Interpreter`.
+template <class Interpreter, bool Enabled = true>
+struct tracing : Interpreter {
+  constexpr static inline bool instruments = Enabled;
+
+  constexpr explicit tracing(trace& target) noexcept : _trace{&target} {}
+
+  template <class D, class F>
+  auto instrument([[maybe_unused]] type_t<D> description, F&& build) const {
+    auto parser = std::forward<F>(build)();
+    return detail::traced_parser<decltype(parser)>{
+        std::move(parser), _trace, detail::type_name<D>()};
+  }
+
+ private:
+  trace* _trace;
+};
+
+template <class Interpreter>
+struct tracing<Interpreter, false> : Interpreter {
+  constexpr explicit tracing([[maybe_unused]] trace& target) noexcept {}
+};
+
+template <class Interpreter, bool Enabled = true, class Description>
+[[nodiscard]] auto make_traced_parser(Description&& desc, trace& target) {
+  return interpreters::make_parser_t<tracing<Interpreter, Enabled>>{
+      tracing<Interpreter, Enabled>{target}}(std::forward<Description>(desc));
+}
+
+}  // namespace parsers
+
+#endif  // GUARD_PARSERS_TRACING_HPP
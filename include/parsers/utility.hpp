@@ -80,6 +80,13 @@ template <class A, class B, class... Args>
 
 template <class T>
 using remove_cvref_t = std::remove_cv_t<std::remove_reference_t<T>>;
+
+// A distinct address per type, to tell at runtime which type was stored
+// behind a `void*`.
+template <class T>
+struct type_key {
+  constexpr static inline char id = 0;
+};
 }  // namespace detail
 
 }  // namespace parsers
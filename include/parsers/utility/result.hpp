@@ -1,6 +1,11 @@
 #ifndef GUARD_DPSG_RESULT_HEADER
 #define GUARD_DPSG_RESULT_HEADER
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
 #include <tuple>
 #include <type_traits>
 #include <utility>
@@ -12,40 +17,207 @@ struct in_place_error_t {
 struct in_place_success_t {
 } constexpr static inline in_place_success;
 
+namespace detail {
 template <class Success, class Error>
-class result {
- private:
-  template <class S, class E>
-  using variant_t = std::variant<S, E>;
-  using variant_type = variant_t<Success, Error>;
+class variant_storage {
+  using variant_type = std::variant<Success, Error>;
   variant_type _value;
   constexpr static inline std::size_t success_index = 0;
   constexpr static inline std::size_t error_index = 1;
 
+ public:
+  template <class T>
+  constexpr explicit variant_storage(
+      [[maybe_unused]] std::in_place_t tag,
+      T&& value) noexcept(std::is_nothrow_constructible_v<variant_type, T>)
+      : _value(std::forward<T>(value)) {}
+
+  template <class... Args>
+  constexpr explicit variant_storage(
+      [[maybe_unused]] in_place_success_t success,
+      Args&&... args) noexcept(std::is_nothrow_constructible_v<Success,
+                                                               Args...>)
+      : _value(std::in_place_index<success_index>,
+               std::forward<Args>(args)...) {}
+
+  template <class... Args>
+  constexpr explicit variant_storage(
+      [[maybe_unused]] in_place_error_t error,
+      Args&&... args) noexcept(std::is_nothrow_constructible_v<Error, Args...>)
+      : _value(std::in_place_index<error_index>, std::forward<Args>(args)...) {}
+
+  [[nodiscard]] constexpr bool has_value() const noexcept {
+    return _value.index() == success_index;
+  }
+  [[nodiscard]] constexpr Success& success() noexcept {
+    return *std::get_if<success_index>(&_value);
+  }
+  [[nodiscard]] constexpr const Success& success() const noexcept {
+    return *std::get_if<success_index>(&_value);
+  }
+  [[nodiscard]] constexpr Error& error() noexcept {
+    return std::get<error_index>(_value);
+  }
+  [[nodiscard]] constexpr const Error& error() const noexcept {
+    return std::get<error_index>(_value);
+  }
+
+  [[nodiscard]] constexpr variant_type& to_variant() & noexcept {
+    return _value;
+  }
+  [[nodiscard]] constexpr const variant_type& to_variant() const& noexcept {
+    return _value;
+  }
+  [[nodiscard]] constexpr variant_type&& to_variant() && noexcept {
+    return std::move(_value);
+  }
+  [[nodiscard]] constexpr const variant_type&& to_variant() const&& noexcept {
+    return std::move(_value);
+  }
+};
+
+template <std::size_t Alignment>
+struct flag_for {
+  using type = std::uint64_t;
+};
+template <>
+struct flag_for<1> {
+  using type = std::uint8_t;
+};
+template <>
+struct flag_for<2> {
+  using type = std::uint16_t;
+};
+template <>
+struct flag_for<4> {
+  using type = std::uint32_t;
+};
+
+// Results of the interpreters are built and checked once per sub-parse, and
+// most of them hold iterators. When both sides can be copied as plain memory
+// they are stored in a tagged union instead of a variant, so that checking a
+// result is a single flag test. `std::pair` is copy-constructed trivially but
+// not assigned trivially, hence the assignment rebuilding the storage. The
+// flag fills the padding after the union: results are copied as whole words,
+// and a narrower flag would be stored as a byte and reloaded as a word.
+template <class Success, class Error>
+class compact_storage {
+  using variant_type = std::variant<Success, Error>;
+  union {
+    Success _success;
+    Error _error;
+  };
+  typename flag_for<std::max(alignof(Success), alignof(Error))>::type
+      _has_value;
+
+  struct from_variant {};
+
+  constexpr explicit compact_storage(
+      [[maybe_unused]] from_variant tag,
+      const variant_type& value) noexcept
+      : compact_storage(value.index() == 0
+                            ? compact_storage{in_place_success,
+                                              *std::get_if<0>(&value)}
+                            : compact_storage{in_place_error,
+                                              *std::get_if<1>(&value)}) {}
+
+ public:
+  template <class T>
+  constexpr explicit compact_storage(
+      [[maybe_unused]] std::in_place_t tag,
+      T&& value) noexcept(std::is_nothrow_constructible_v<variant_type, T>)
+      : compact_storage(from_variant{}, variant_type(std::forward<T>(value))) {}
+
+  template <class... Args>
+  constexpr explicit compact_storage(
+      [[maybe_unused]] in_place_success_t success,
+      Args&&... args) noexcept(std::is_nothrow_constructible_v<Success,
+                                                               Args...>)
+      : _success(std::forward<Args>(args)...), _has_value{1} {}
+
+  template <class... Args>
+  constexpr explicit compact_storage(
+      [[maybe_unused]] in_place_error_t error,
+      Args&&... args) noexcept(std::is_nothrow_constructible_v<Error, Args...>)
+      : _error(std::forward<Args>(args)...), _has_value{0} {}
+
+  constexpr compact_storage(const compact_storage&) noexcept = default;
+
+  constexpr compact_storage& operator=(const compact_storage& other) noexcept {
+#if defined(__cpp_lib_constexpr_dynamic_alloc)
+    std::construct_at(this, other);
+#else
+    ::new (static_cast<void*>(this)) compact_storage(other);
+#endif
+    return *this;
+  }
+
+  [[nodiscard]] constexpr bool has_value() const noexcept {
+    return _has_value != 0;
+  }
+  [[nodiscard]] constexpr Success& success() noexcept { return _success; }
+  [[nodiscard]] constexpr const Success& success() const noexcept {
+    return _success;
+  }
+  [[nodiscard]] constexpr Error& error() noexcept { return _error; }
+  [[nodiscard]] constexpr const Error& error() const noexcept {
+    return _error;
+  }
+
+  [[nodiscard]] constexpr variant_type to_variant() const noexcept {
+    if (_has_value) {
+      return variant_type{std::in_place_index<0>, _success};
+    }
+    return variant_type{std::in_place_index<1>, _error};
+  }
+};
+
+template <class Success, class Error>
+constexpr static inline bool is_compact_v =
+    std::conjunction_v<std::is_trivially_copy_constructible<Success>,
+                       std::is_trivially_destructible<Success>,
+                       std::is_trivially_copy_constructible<Error>,
+                       std::is_trivially_destructible<Error>>;
+
+template <class Success, class Error>
+using result_storage_t = std::conditional_t<is_compact_v<Success, Error>,
+                                            compact_storage<Success, Error>,
+                                            variant_storage<Success, Error>>;
+}  // namespace detail
+
+template <class Success, class Error>
+class result {
+ private:
+  using variant_type = std::variant<Success, Error>;
+  using storage_type = detail::result_storage_t<Success, Error>;
+  storage_type _value;
+
  public:
   using success_type = Success;
   using error_type = Error;
 
+  constexpr static inline bool is_compact =
+      detail::is_compact_v<Success, Error>;
+
   template <class T,
             std::enable_if_t<std::is_convertible_v<T, variant_type>, int> = 0>
   constexpr explicit result(T&& value) noexcept(
       std::is_nothrow_constructible_v<variant_type, T>)
-      : _value(std::forward<T>(value)) {}
+      : _value(std::in_place, std::forward<T>(value)) {}
 
   template <class... Args>
   constexpr explicit result(
       [[maybe_unused]] in_place_success_t success,
       Args&&... args) noexcept(std::is_nothrow_constructible_v<success_type,
                                                                Args...>)
-      : _value(std::in_place_index<success_index>,
-               std::forward<Args>(args)...) {}
+      : _value(in_place_success, std::forward<Args>(args)...) {}
 
   template <class... Args>
   constexpr explicit result(
       [[maybe_unused]] in_place_error_t error,
       Args&&... args) noexcept(std::is_nothrow_constructible_v<error_type,
                                                                Args...>)
-      : _value(std::in_place_type<Error>, std::forward<Args>(args)...) {}
+      : _value(in_place_error, std::forward<Args>(args)...) {}
 
   template <
       class V,
@@ -60,20 +232,20 @@ class result {
           int> = 0>
   constexpr explicit result(V&& val)
       : _value(std::forward<V>(val).either(
-            [](auto&& success) -> variant_type {
-              return variant_type{std::in_place_type<success_type>,
+            [](auto&& success) -> storage_type {
+              return storage_type{in_place_success,
                                   std::forward<decltype(success)>(success)};
             },
-            [](auto&& error) -> variant_type {
-              return variant_type{std::in_place_type<error_type>,
+            [](auto&& error) -> storage_type {
+              return storage_type{in_place_error,
                                   std::forward<decltype(error)>(error)};
             })) {}
 
   [[nodiscard]] inline constexpr bool has_value() const {
-    return _value.index() == success_index;
+    return _value.has_value();
   }
   [[nodiscard]] inline constexpr bool is_error() const {
-    return _value.index() == error_index;
+    return !_value.has_value();
   }
   [[nodiscard]] inline constexpr bool is_success() const { return has_value(); }
   [[nodiscard]] inline constexpr operator bool() const {  // NOLINT
@@ -92,8 +264,8 @@ class result {
                                          std::invoke_result_t<G, error_type&>>>
   constexpr inline R either(F&& on_success, G&& on_error) & noexcept(
       noexcept_call<F, success_type&>&& noexcept_call<G, error_type&>) {
-    if (success_type* ptr = std::get_if<success_index>(&_value)) {
-      return std::forward<F>(on_success)(*ptr);
+    if (has_value()) {
+      return std::forward<F>(on_success)(_value.success());
     }
     return std::forward<G>(on_error)(error());
   }
@@ -106,8 +278,8 @@ class result {
   constexpr inline R either(F&& on_success, G&& on_error) const& noexcept(
       noexcept_call<F, const success_type&>&&
           noexcept_call<G, const error_type&>) {
-    if (const success_type* ptr = std::get_if<success_index>(&_value)) {
-      return std::forward<F>(on_success)(*ptr);
+    if (has_value()) {
+      return std::forward<F>(on_success)(_value.success());
     }
     return std::forward<G>(on_error)(error());
   }
@@ -119,8 +291,8 @@ class result {
                                    std::invoke_result_t<G, error_type&&>>>
   constexpr inline R either(F&& on_success, G&& on_error) && noexcept(
       noexcept_call<F, success_type&&>&& noexcept_call<G, error_type&&>) {
-    if (success_type* ptr = std::get_if<success_index>(&_value)) {
-      return std::forward<F>(on_success)(std::move(*ptr));
+    if (has_value()) {
+      return std::forward<F>(on_success)(std::move(_value.success()));
     }
     return std::forward<G>(on_error)(error());
   }
@@ -133,80 +305,112 @@ class result {
   constexpr inline R either(F&& on_success, G&& on_error) const&& noexcept(
       noexcept_call<F, const success_type&&>&&
           noexcept_call<G, const error_type&&>) {
-    if (const success_type* ptr = std::get_if<success_index>(&_value)) {
-      return std::forward<F>(on_success)(std::move(*ptr));
+    if (has_value()) {
+      return std::forward<F>(on_success)(std::move(_value.success()));
     }
     return std::forward<G>(on_error)(error());
   }
 
+  // Kept out of line so that `value()` stays small enough to be inlined in
+  // the interpreters.
+  template <class E>
+  [[noreturn]] static void raise(E&& error) {
+    throw std::forward<E>(error);
+  }
+
   [[nodiscard]] constexpr inline const success_type& value() const& {
-    if (const success_type* ptr = std::get_if<success_index>(&_value)) {
-      return *ptr;
+    if (has_value()) {
+      return _value.success();
     }
-    throw error();
+    raise(error());
   }
 
   [[nodiscard]] constexpr inline success_type& value() & {
-    if (success_type* ptr = std::get_if<success_index>(&_value)) {
-      return *ptr;
+    if (has_value()) {
+      return _value.success();
     }
-    throw error();
+    raise(error());
   }
 
   [[nodiscard]] constexpr inline const success_type&& value() const&& {
-    if (const success_type* ptr = std::get_if<success_index>(&_value)) {
-      return std::move(*ptr);
+    if (has_value()) {
+      return std::move(_value.success());
     }
-    throw error();
+    raise(error());
   }
 
   [[nodiscard]] constexpr inline success_type&& value() && {
-    if (success_type* ptr = std::get_if<success_index>(&_value)) {
-      return std::move(*ptr);
+    if (has_value()) {
+      return std::move(_value.success());
     }
-    throw std::get<error_index>(std::move(_value));
+    raise(std::move(_value.error()));
   }
 
   template <class T = success_type,
             std::enable_if_t<std::is_convertible_v<T, success_type>>>
   [[nodiscard]] constexpr inline success_type value_or(
       T default_) const& noexcept {
-    if (const success_type* ptr = std::get_if<success_index>(&_value)) {
-      return *ptr;
+    if (has_value()) {
+      return _value.success();
     }
     return static_cast<success_type>(default_);
   }
 
+  // Unchecked accesses, for callers that already tested `has_value()`.
+  [[nodiscard]] constexpr success_type& operator*() & noexcept {
+    return _value.success();
+  }
+
+  [[nodiscard]] constexpr const success_type& operator*() const& noexcept {
+    return _value.success();
+  }
+
+  [[nodiscard]] constexpr success_type&& operator*() && noexcept {
+    return std::move(_value.success());
+  }
+
+  [[nodiscard]] constexpr const success_type&& operator*() const&& noexcept {
+    return std::move(_value.success());
+  }
+
+  [[nodiscard]] constexpr success_type* operator->() noexcept {
+    return &_value.success();
+  }
+
+  [[nodiscard]] constexpr const success_type* operator->() const noexcept {
+    return &_value.success();
+  }
+
   [[nodiscard]] constexpr error_type& error() & noexcept {
-    return std::get<error_index>(_value);
+    return _value.error();
   }
 
   [[nodiscard]] constexpr const error_type& error() const& noexcept {
-    return std::get<error_index>(_value);
+    return _value.error();
   }
 
   [[nodiscard]] constexpr error_type&& error() && noexcept {
-    return std::get<error_index>(std::move(_value));
+    return std::move(_value.error());
   }
 
   [[nodiscard]] constexpr const error_type&& error() const&& noexcept {
-    return std::get<error_index>(std::move(_value));
+    return std::move(_value.error());
   }
 
-  [[nodiscard]] constexpr variant_type& to_variant() & noexcept {
-    return _value;
+  [[nodiscard]] constexpr decltype(auto) to_variant() & noexcept {
+    return _value.to_variant();
   }
 
-  [[nodiscard]] constexpr const variant_type& to_variant() const& noexcept {
-    return _value;
+  [[nodiscard]] constexpr decltype(auto) to_variant() const& noexcept {
+    return _value.to_variant();
   }
 
-  [[nodiscard]] constexpr variant_type&& to_variant() && noexcept {
-    return std::move(_value);
+  [[nodiscard]] constexpr decltype(auto) to_variant() && noexcept {
+    return std::move(_value).to_variant();
   }
 
-  [[nodiscard]] constexpr const variant_type&& to_variant() const&& noexcept {
-    return std::move(_value);
+  [[nodiscard]] constexpr decltype(auto) to_variant() const&& noexcept {
+    return std::move(_value).to_variant();
   }
 
   template <class F, class S = std::invoke_result_t<F, const success_type&>>
@@ -215,7 +419,7 @@ class result {
     if (has_value()) {
       return result<S, error_type>{
           in_place_success,
-          std::forward<F>(f)(std::get<success_index>(_value))};
+          std::forward<F>(f)(_value.success())};
     }
     return result<S, error_type>{in_place_error, error()};
   }
@@ -226,7 +430,7 @@ class result {
     if (has_value()) {
       return result<S, error_type>{
           in_place_success,
-          std::forward<F>(f)(std::get<success_index>(std::move(_value)))};
+          std::forward<F>(f)(std::move(_value.success()))};
     }
     return result<S, error_type>{in_place_error, std::move(error())};
   }
@@ -236,7 +440,7 @@ class result {
       F&& f) const& noexcept(noexcept_call<F, const error_type&>) {
     if (!has_value()) {
       return result<success_type, E>{
-          in_place_error, std::forward<F>(f)(std::get<error_index>(_value))};
+          in_place_error, std::forward<F>(f)(_value.error())};
     }
     return result<success_type, E>{in_place_success, value()};
   }
@@ -247,7 +451,7 @@ class result {
     if (!has_value()) {
       return result<success_type, E>{
           in_place_error,
-          std::forward<F>(f)(std::get<error_index>(std::move(_value)))};
+          std::forward<F>(f)(std::move(_value.error()))};
     }
     return result<success_type, E>{in_place_success, std::move(value())};
   }
@@ -260,7 +464,7 @@ class result {
   [[nodiscard]] constexpr R then(F&& f) const& noexcept(
       noexcept_call<F, const success_type&>) {
     if (has_value()) {
-      return std::forward<F>(f)(std::get<success_index>(_value));
+      return std::forward<F>(f)(_value.success());
     }
     return R{in_place_error, error()};
   }
@@ -273,7 +477,7 @@ class result {
   [[nodiscard]] constexpr R then(F&& f) && noexcept(
       noexcept_call<F, success_type&&>) {
     if (has_value()) {
-      return std::forward<F>(f)(std::get<success_index>(std::move(_value)));
+      return std::forward<F>(f)(std::move(_value.success()));
     }
     return R{in_place_error, std::move(error())};
   }
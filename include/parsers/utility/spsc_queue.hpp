@@ -0,0 +1,103 @@
+#ifndef GUARD_DPSG_SPSC_QUEUE_HPP
+#define GUARD_DPSG_SPSC_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <utility>
+
+/* template<class T> class spsc_queue;
+
+    A bounded, lock-free queue for exactly one producer thread and one
+   consumer thread. The capacity is rounded up to a power of two. try_push
+   fails when the queue is full and try_pop returns an empty optional when it
+   is empty, leaving the caller free to decide how to wait.
+
+        dpsg::spsc_queue<int> queue{64};
+
+        std::thread producer{[&] {
+          for (int i = 0; i < 1000; ++i) {
+            while (!queue.try_push(i)) {
+              std::this_thread::yield();
+            }
+          }
+        }};
+
+        for (int received = 0; received < 1000;) {
+          if (auto i = queue.try_pop()) {
+            ++received;
+          }
+        }
+        producer.join();
+*/
+namespace dpsg {
+
+template <class T>
+class spsc_queue {
+ public:
+  explicit spsc_queue(std::size_t capacity)
+      : _mask{round_up(capacity) - 1},
+        _storage{std::make_unique<std::optional<T>[]>(_mask + 1)} {}
+
+  spsc_queue(const spsc_queue&) = delete;
+  spsc_queue& operator=(const spsc_queue&) = delete;
+  spsc_queue(spsc_queue&&) = delete;
+  spsc_queue& operator=(spsc_queue&&) = delete;
+  ~spsc_queue() = default;
+
+  template <class U>
+  [[nodiscard]] bool try_push(U&& value) {
+    const auto tail = _tail.load(std::memory_order_relaxed);
+    if (tail - _head_cache > _mask) {
+      _head_cache = _head.load(std::memory_order_acquire);
+      if (tail - _head_cache > _mask) {
+        return false;
+      }
+    }
+    _storage[tail & _mask].emplace(std::forward<U>(value));
+    _tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  [[nodiscard]] std::optional<T> try_pop() {
+    const auto head = _head.load(std::memory_order_relaxed);
+    if (head == _tail_cache) {
+      _tail_cache = _tail.load(std::memory_order_acquire);
+      if (head == _tail_cache) {
+        return std::nullopt;
+      }
+    }
+    auto& slot = _storage[head & _mask];
+    std::optional<T> value{std::move(slot)};
+    slot.reset();
+    _head.store(head + 1, std::memory_order_release);
+    return value;
+  }
+
+  [[nodiscard]] std::size_t capacity() const noexcept { return _mask + 1; }
+
+ private:
+  [[nodiscard]] static std::size_t round_up(std::size_t capacity) noexcept {
+    std::size_t result = 1;
+    while (result < capacity) {
+      result <<= 1U;
+    }
+    return result;
+  }
+
+  constexpr static inline std::size_t cache_line = 64;
+
+  const std::size_t _mask;
+  std::unique_ptr<std::optional<T>[]> _storage;
+
+  alignas(cache_line) std::atomic<std::size_t> _head{0};
+  std::size_t _tail_cache{0};
+
+  alignas(cache_line) std::atomic<std::size_t> _tail{0};
+  std::size_t _head_cache{0};
+};
+
+}  // namespace dpsg
+
+#endif  // GUARD_DPSG_SPSC_QUEUE_HPP
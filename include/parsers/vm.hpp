@@ -0,0 +1,725 @@
+#ifndef GUARD_PARSERS_VM_HPP
+#define GUARD_PARSERS_VM_HPP
+
+#include "./description.hpp"
+#include "./interpreters/range_parser.hpp"
+#include "./utility.hpp"
+
+#include <algorithm>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace parsers::vm {
+
+enum class opcode : std::uint8_t {
+  character,       // consume the byte `arg`
+  set,             // consume a byte belonging to the set `arg`
+  string,          // consume the string `arg`
+  any,             // consume any byte
+  span,            // consume every byte belonging to the set `arg`
+  test_set,        // skip the next instruction if the byte is in the set `arg`
+  end_of_input,    // fail unless the input is exhausted
+  test_end,        // jump to `arg` if the input is exhausted
+  trie,            // consume the first literal of the trie `arg` that matches
+  choice,          // push a backtrack point to `arg`
+  commit,          // pop the last backtrack point and jump to `arg`
+  partial_commit,  // move the last backtrack point here and jump to `arg`
+  back_commit,     // pop the last backtrack point, restore it, jump to `arg`
+  jump,            // jump to `arg`
+  call,            // push the return address and jump to `arg`
+  ret,             // pop the return address and jump to it
+  fail,            // backtrack to the last backtrack point
+  fail_twice,      // drop the last backtrack point and backtrack
+  open_capture,    // start the capture `arg`
+  close_capture,   // end the capture `arg`
+  checkpoint,      // remember the current position to report failures
+  end,             // the input matched
+};
+
+struct instruction {
+  opcode op;
+  std::uint32_t arg;
+};
+
+class program {
+ public:
+  using set_t = std::bitset<256>;
+  template <class It>
+  using result_t = interpreters::range_parser::result_t<It>;
+  template <class It>
+  using captures_t = std::vector<std::optional<std::pair<It, It>>>;
+
+  std::uint32_t emit(opcode op, std::uint32_t arg = 0) {
+    _code.push_back(instruction{op, arg});
+    return static_cast<std::uint32_t>(_code.size() - 1);
+  }
+
+  void patch(std::uint32_t at, std::uint32_t arg) noexcept {
+    _code[at].arg = arg;
+  }
+
+  [[nodiscard]] std::uint32_t here() const noexcept {
+    return static_cast<std::uint32_t>(_code.size());
+  }
+
+  std::uint32_t add_set(const set_t& set) {
+    for (std::size_t i = 0; i < _sets.size(); ++i) {
+      if (_sets[i] == set) {
+        return static_cast<std::uint32_t>(i);
+      }
+    }
+    _sets.push_back(set);
+    return static_cast<std::uint32_t>(_sets.size() - 1);
+  }
+
+  std::uint32_t add_string(std::string_view str) {
+    _strings.emplace_back(_characters.size(), str.size());
+    _characters.append(str);
+    return static_cast<std::uint32_t>(_strings.size() - 1);
+  }
+
+  std::uint32_t add_capture() noexcept { return _capture_count++; }
+
+  // Literals are numbered by their position in `literals`; the trie consumes
+  // the lowest numbered one that prefixes the input, like an ordered choice.
+  template <class Literals>
+  std::uint32_t add_trie(const Literals& literals) {
+    std::vector<std::vector<std::pair<unsigned char, std::uint32_t>>> children(
+        1);
+    std::vector<std::uint32_t> accepts(1, no_literal);
+    std::uint32_t index = 0;
+    for (const auto& literal : literals) {
+      std::uint32_t node = 0;
+      for (const auto c : literal) {
+        const auto byte = static_cast<unsigned char>(c);
+        auto& edges = children[node];
+        auto it = std::find_if(edges.begin(), edges.end(), [byte](auto edge) {
+          return edge.first == byte;
+        });
+        if (it == edges.end()) {
+          const auto next = static_cast<std::uint32_t>(children.size());
+          edges.emplace_back(byte, next);
+          children.emplace_back();
+          accepts.push_back(no_literal);
+          node = next;
+        }
+        else {
+          node = it->second;
+        }
+      }
+      accepts[node] = std::min(accepts[node], index++);
+    }
+
+    const auto root = static_cast<std::uint32_t>(_trie_nodes.size());
+    for (std::size_t node = 0; node < children.size(); ++node) {
+      auto& edges = children[node];
+      std::sort(edges.begin(), edges.end());
+      _trie_nodes.push_back(
+          trie_node{static_cast<std::uint32_t>(_trie_edges.size()),
+                    static_cast<std::uint32_t>(edges.size()),
+                    accepts[node]});
+      for (const auto [byte, next] : edges) {
+        _trie_edges.emplace_back(byte, root + next);
+      }
+    }
+    return root;
+  }
+
+  [[nodiscard]] const std::vector<instruction>& code() const noexcept {
+    return _code;
+  }
+
+  [[nodiscard]] const set_t& set(std::uint32_t index) const noexcept {
+    return _sets[index];
+  }
+
+  [[nodiscard]] std::string_view string(std::uint32_t index) const noexcept {
+    const auto [offset, size] = _strings[index];
+    return std::string_view{_characters}.substr(offset, size);
+  }
+
+  [[nodiscard]] std::size_t capture_count() const noexcept {
+    return _capture_count;
+  }
+
+  template <class ItB, class ItE>
+  [[nodiscard]] result_t<ItB> operator()(ItB begin, ItE end) const {
+    return run(begin, end, static_cast<captures_t<ItB>*>(nullptr));
+  }
+
+  template <class ItB, class ItE>
+  [[nodiscard]] result_t<ItB> operator()(ItB begin,
+                                         ItE end,
+                                         captures_t<ItB>& captures) const {
+    return run(begin, end, &captures);
+  }
+
+ private:
+  template <class ItB, class ItE>
+  result_t<ItB> run(ItB begin, ItE end, captures_t<ItB>* captures) const {
+    static_assert(sizeof(detail::remove_cvref_t<decltype(*begin)>) == 1,
+                  "Programs match sequences of bytes");
+    struct frame {
+      std::uint32_t pc;
+      ItB position;
+      std::size_t log_size;
+      bool is_choice;
+    };
+    struct capture_event {
+      std::uint32_t index;
+      ItB position;
+      bool open;
+    };
+    std::vector<frame> stack;
+    std::vector<capture_event> log;
+    std::uint32_t pc = 0;
+    ItB current = begin;
+    ItB failure_position = begin;
+
+    const instruction* code = _code.data();
+    for (;;) {
+      const auto& i = code[pc];
+      switch (i.op) {
+        case opcode::character:
+          if (current != end &&
+              static_cast<unsigned char>(*current) == i.arg) {
+            ++current;
+            ++pc;
+            continue;
+          }
+          break;
+        case opcode::set:
+          if (current != end &&
+              _sets[i.arg][static_cast<unsigned char>(*current)]) {
+            ++current;
+            ++pc;
+            continue;
+          }
+          break;
+        case opcode::string: {
+          const auto str = string(i.arg);
+          auto it = current;
+          auto s = str.begin();
+          while (s != str.end() && it != end &&
+                 static_cast<char>(*it) == *s) {
+            ++it;
+            ++s;
+          }
+          if (s == str.end()) {
+            current = it;
+            ++pc;
+            continue;
+          }
+          break;
+        }
+        case opcode::span:
+          while (current != end &&
+                 _sets[i.arg][static_cast<unsigned char>(*current)]) {
+            ++current;
+          }
+          ++pc;
+          continue;
+        case opcode::any:
+          if (current != end) {
+            ++current;
+            ++pc;
+            continue;
+          }
+          break;
+        case opcode::test_set:
+          pc += current != end &&
+                        _sets[i.arg][static_cast<unsigned char>(*current)]
+                    ? 2
+                    : 1;
+          continue;
+        case opcode::trie: {
+          auto node = &_trie_nodes[i.arg];
+          auto accepted = node->literal;
+          auto accepted_end = current;
+          for (auto it = current; it != end;) {
+            const auto first = _trie_edges.begin() + node->first_edge;
+            const auto last = first + node->edge_count;
+            const auto byte = static_cast<unsigned char>(*it);
+            const auto edge = std::lower_bound(
+                first, last, byte, [](const auto& e, unsigned char b) {
+                  return e.first < b;
+                });
+            if (edge == last || edge->first != byte) {
+              break;
+            }
+            ++it;
+            node = &_trie_nodes[edge->second];
+            if (node->literal < accepted) {
+              accepted = node->literal;
+              accepted_end = it;
+            }
+          }
+          if (accepted != no_literal) {
+            current = accepted_end;
+            ++pc;
+            continue;
+          }
+          break;
+        }
+        case opcode::end_of_input:
+          if (current == end) {
+            ++pc;
+            continue;
+          }
+          break;
+        case opcode::test_end:
+          pc = current == end ? i.arg : pc + 1;
+          continue;
+        case opcode::choice:
+          stack.push_back(frame{i.arg, current, log.size(), true});
+          ++pc;
+          continue;
+        case opcode::commit:
+          stack.pop_back();
+          pc = i.arg;
+          continue;
+        case opcode::partial_commit:
+          stack.back().position = current;
+          stack.back().log_size = log.size();
+          pc = i.arg;
+          continue;
+        case opcode::back_commit:
+          current = stack.back().position;
+          if (log.size() != stack.back().log_size) {
+            log.resize(stack.back().log_size);
+          }
+          stack.pop_back();
+          pc = i.arg;
+          continue;
+        case opcode::jump:
+          pc = i.arg;
+          continue;
+        case opcode::call:
+          stack.push_back(frame{pc + 1, current, log.size(), false});
+          pc = i.arg;
+          continue;
+        case opcode::ret:
+          pc = stack.back().pc;
+          stack.pop_back();
+          continue;
+        case opcode::fail:
+          break;
+        case opcode::fail_twice:
+          stack.pop_back();
+          break;
+        case opcode::open_capture:
+        case opcode::close_capture:
+          log.push_back(
+              capture_event{i.arg, current, i.op == opcode::open_capture});
+          ++pc;
+          continue;
+        case opcode::checkpoint:
+          failure_position = current;
+          ++pc;
+          continue;
+        case opcode::end:
+          if (captures != nullptr) {
+            captures->assign(_capture_count, std::nullopt);
+            std::vector<ItB> opened(_capture_count, begin);
+            for (const auto& event : log) {
+              if (event.open) {
+                opened[event.index] = event.position;
+              }
+              else {
+                (*captures)[event.index].emplace(opened[event.index],
+                                                 event.position);
+              }
+            }
+          }
+          return dpsg::success(begin, current);
+      }
+
+      while (!stack.empty() && !stack.back().is_choice) {
+        stack.pop_back();
+      }
+      if (stack.empty()) {
+        return dpsg::failure(failure_position);
+      }
+      const auto& last = stack.back();
+      pc = last.pc;
+      current = last.position;
+      if (log.size() != last.log_size) {
+        log.resize(last.log_size);
+      }
+      stack.pop_back();
+    }
+  }
+
+  struct trie_node {
+    std::uint32_t first_edge;
+    std::uint32_t edge_count;
+    std::uint32_t literal;
+  };
+  constexpr static inline std::uint32_t no_literal = 0xFFFFFFFF;
+
+  std::vector<instruction> _code;
+  std::vector<set_t> _sets;
+  std::vector<trie_node> _trie_nodes;
+  std::vector<std::pair<unsigned char, std::uint32_t>> _trie_edges;
+  std::vector<std::pair<std::size_t, std::size_t>> _strings;
+  std::string _characters;
+  std::uint32_t _capture_count = 0;
+};
+
+namespace detail {
+using namespace ::parsers::detail;
+
+template <class T>
+struct rule_key {
+  constexpr static inline char id = 0;
+};
+
+template <class T>
+constexpr std::true_type is_ascii_class_f(
+    const description::ascii::character_class<T>&) noexcept;
+constexpr std::false_type is_ascii_class_f(...) noexcept;
+
+template <class T>
+constexpr std::true_type is_single_character_f(
+    const description::satisfy_character<T>&) noexcept;
+constexpr std::false_type is_single_character_f(...) noexcept;
+
+template <class T, class = void>
+struct is_character_set
+    : std::disjunction<std::is_integral<T>,
+                       decltype(is_single_character_f(std::declval<T>()))> {};
+template <class... Ts>
+struct is_character_set<type_list_t<Ts...>>
+    : std::conjunction<is_character_set<Ts>...> {};
+template <class T>
+struct is_character_set<T, std::enable_if_t<description::is_alternative_v<T>>>
+    : is_character_set<dpsg::feed_t<T, type_list_t>> {};
+template <class T>
+constexpr static inline bool is_character_set_v = is_character_set<T>::value;
+
+template <class T>
+constexpr static inline bool dependent_false_v = false;
+
+class compiler {
+ public:
+  explicit compiler(program& p) noexcept : _program{p} {}
+
+  template <class D>
+  void compile(const D& desc, bool top) {
+    using namespace description;
+    if constexpr (std::is_integral_v<D>) {
+      _program.emit(opcode::character, static_cast<unsigned char>(desc));
+    }
+    else if constexpr (std::is_array_v<D>) {
+      _program.emit(opcode::string,
+                    _program.add_string(std::string_view{
+                        desc, std::extent_v<D> - 1}));
+    }
+    else if constexpr (is_recursive_v<D>) {
+      if (top) {
+        compile(desc.parser(), true);
+      }
+      else {
+        _calls.push_back(_program.emit(opcode::call, rule<D>(desc)));
+      }
+    }
+    else if constexpr (is_sequence_v<D>) {
+      compile_sequence(
+          desc, top, std::make_index_sequence<D::sequence_length>{});
+    }
+    else if constexpr (is_alternative_v<D> && is_character_set_v<D>) {
+      program::set_t set;
+      insert(desc, set);
+      emit_set(set);
+    }
+    else if constexpr (is_alternative_v<D>) {
+      compile_alternative(desc, std::make_index_sequence<D::sequence_length>{});
+    }
+    else if constexpr (is_dynamic_range_v<D>) {
+      compile_repetition(desc.parser(), desc.count(), top);
+    }
+    else if constexpr (is_lazy_v<D>) {
+      const auto loop = _program.emit(opcode::test_end);
+      _program.emit(opcode::any);
+      _program.emit(opcode::jump, loop);
+      _program.patch(loop, _program.here());
+    }
+    else if constexpr (is_modifier_v<D>) {
+      compile(desc.inner_parser(), false);
+    }
+    else if constexpr (std::is_same_v<D, end_t>) {
+      _program.emit(opcode::end_of_input);
+    }
+    else if constexpr (std::is_same_v<D, succeed_t>) {
+    }
+    else if constexpr (is_failure_v<D>) {
+      _program.emit(opcode::fail);
+    }
+    else if constexpr (std::is_same_v<D, any_t>) {
+      _program.emit(opcode::any);
+    }
+    else if constexpr (dpsg::is_template_instance_v<D, static_string>) {
+      std::string str;
+      for (auto c : desc) {
+        str.push_back(static_cast<char>(c));
+      }
+      _program.emit(opcode::string, _program.add_string(str));
+    }
+    else if constexpr (is_character_set_v<D>) {
+      program::set_t set;
+      insert(desc, set);
+      emit_set(set);
+    }
+    else {
+      static_assert(dependent_false_v<D>,
+                    "This description can't be compiled to bytecode");
+    }
+  }
+
+  void finish() {
+    _program.emit(opcode::end);
+    // Compiling a rule can find new ones: the task is moved out of the
+    // vector before running, as appending to it may reallocate.
+    for (std::size_t i = 0; i < _pending.size(); ++i) {
+      const auto task = std::move(_pending[i]);
+      task();
+    }
+    for (auto call : _calls) {
+      _program.patch(call, _addresses[_program.code()[call].arg]);
+    }
+  }
+
+ private:
+  template <class D>
+  std::uint32_t rule(const D& desc) {
+    const void* key = &rule_key<D>::id;
+    for (const auto& [k, index] : _rules) {
+      if (k == key) {
+        return index;
+      }
+    }
+    const auto index = static_cast<std::uint32_t>(_addresses.size());
+    _rules.emplace_back(key, index);
+    _addresses.push_back(0);
+    _pending.emplace_back([this, index, parser = desc.parser()] {
+      _addresses[index] = _program.here();
+      compile(parser, false);
+      _program.emit(opcode::ret);
+    });
+    return index;
+  }
+
+  template <class D>
+  static void insert(const D& desc, program::set_t& set) {
+    if constexpr (std::is_integral_v<D>) {
+      set.set(static_cast<unsigned char>(desc));
+    }
+    else if constexpr (description::is_alternative_v<D>) {
+      insert_each(desc, set, std::make_index_sequence<D::sequence_length>{});
+    }
+    else {
+      constexpr std::size_t size =
+          decltype(is_ascii_class_f(desc))::value ? 128 : 256;
+      for (std::size_t i = 0; i < size; ++i) {
+        if (desc(static_cast<char>(i))) {
+          set.set(i);
+        }
+      }
+    }
+  }
+
+  template <class D, std::size_t... Is>
+  static void insert_each(const D& desc,
+                          program::set_t& set,
+                          [[maybe_unused]] std::index_sequence<Is...>) {
+    (insert(desc.template parser<Is>(), set), ...);
+  }
+
+  void emit_set(const program::set_t& set) {
+    if (set.all()) {
+      _program.emit(opcode::any);
+    }
+    else if (set.count() == 1) {
+      for (std::size_t i = 0; i < set.size(); ++i) {
+        if (set[i]) {
+          _program.emit(opcode::character, static_cast<std::uint32_t>(i));
+        }
+      }
+    }
+    else {
+      _program.emit(opcode::set, _program.add_set(set));
+    }
+  }
+
+  template <class D, std::size_t... Is>
+  void compile_sequence(const D& desc,
+                        bool top,
+                        [[maybe_unused]] std::index_sequence<Is...>) {
+    (compile_element(desc.template parser<Is>(), top), ...);
+  }
+
+  template <class D>
+  void compile_element(const D& desc, bool top) {
+    if (top) {
+      _program.emit(opcode::checkpoint);
+    }
+    compile(desc, false);
+  }
+
+  template <class D, std::size_t... Is>
+  void compile_alternative(const D& desc,
+                           [[maybe_unused]] std::index_sequence<Is...>) {
+    std::vector<std::uint32_t> commits;
+    (compile_branch(desc.template parser<Is>(),
+                    Is + 1 == sizeof...(Is),
+                    commits),
+     ...);
+    for (auto commit : commits) {
+      _program.patch(commit, _program.here());
+    }
+  }
+
+  template <class D>
+  void compile_branch(const D& desc,
+                      bool last,
+                      std::vector<std::uint32_t>& commits) {
+    if (last) {
+      compile(desc, false);
+      return;
+    }
+    std::optional<std::uint32_t> skip;
+    if (program::set_t set; first_set(desc, set)) {
+      _program.emit(opcode::test_set, _program.add_set(set));
+      skip = _program.emit(opcode::jump);
+    }
+    const auto choice = _program.emit(opcode::choice);
+    compile(desc, false);
+    commits.push_back(_program.emit(opcode::commit));
+    _program.patch(choice, _program.here());
+    if (skip) {
+      _program.patch(*skip, _program.here());
+    }
+  }
+
+  // Computes the bytes a description must start with, if it can't succeed
+  // without consuming one of them.
+  template <class D>
+  static bool first_set(const D& desc, program::set_t& set) {
+    using namespace description;
+    if constexpr (is_character_set_v<D>) {
+      insert(desc, set);
+      return true;
+    }
+    else if constexpr (std::is_array_v<D>) {
+      if (std::extent_v<D> < 2) {
+        return false;
+      }
+      set.set(static_cast<unsigned char>(desc[0]));
+      return true;
+    }
+    else if constexpr (dpsg::is_template_instance_v<D, static_string>) {
+      if (desc.begin() == desc.end()) {
+        return false;
+      }
+      set.set(static_cast<unsigned char>(*desc.begin()));
+      return true;
+    }
+    else if constexpr (is_sequence_v<D>) {
+      return first_set(desc.template parser<0>(), set);
+    }
+    else if constexpr (is_alternative_v<D>) {
+      return first_set_each(
+          desc, set, std::make_index_sequence<D::sequence_length>{});
+    }
+    else if constexpr (is_dynamic_range_v<D>) {
+      return desc.count() > 0 && first_set(desc.parser(), set);
+    }
+    else if constexpr (is_modifier_v<D>) {
+      return first_set(desc.inner_parser(), set);
+    }
+    else {
+      return false;
+    }
+  }
+
+  template <class D, std::size_t... Is>
+  static bool first_set_each(const D& desc,
+                             program::set_t& set,
+                             [[maybe_unused]] std::index_sequence<Is...>) {
+    return (first_set(desc.template parser<Is>(), set) && ...);
+  }
+
+  // Mirrors dynamic_range_parser: the element is never tried at the end of
+  // the input, and the count is only checked once the loop stops.
+  template <class P>
+  void compile_repetition(const P& element, std::size_t count, bool top) {
+    if constexpr (is_character_set_v<P>) {
+      program::set_t set;
+      insert(element, set);
+      for (std::size_t i = 0; i < count; ++i) {
+        emit_set(set);
+        if (top) {
+          _program.emit(opcode::checkpoint);
+        }
+      }
+      _program.emit(opcode::span, _program.add_set(set));
+      return;
+    }
+    std::vector<std::uint32_t> at_end;
+    for (std::size_t i = 0; i < count; ++i) {
+      at_end.push_back(_program.emit(opcode::test_end));
+      compile(element, false);
+      if (top) {
+        _program.emit(opcode::checkpoint);
+      }
+    }
+    if (!at_end.empty()) {
+      const auto skip = _program.emit(opcode::jump);
+      const auto failure = _program.emit(opcode::fail);
+      for (auto test : at_end) {
+        _program.patch(test, failure);
+      }
+      _program.patch(skip, _program.here());
+    }
+
+    const auto choice = _program.emit(opcode::choice);
+    const auto loop = _program.emit(opcode::test_end);
+    compile(element, false);
+    if (top) {
+      _program.emit(opcode::checkpoint);
+    }
+    _program.emit(opcode::partial_commit, loop);
+    const auto done = _program.emit(opcode::commit);
+    _program.patch(choice, _program.here());
+    _program.patch(loop, done);
+    _program.patch(done, _program.here());
+  }
+
+  program& _program;
+  std::vector<std::pair<const void*, std::uint32_t>> _rules;
+  std::vector<std::uint32_t> _addresses;
+  std::vector<std::function<void()>> _pending;
+  std::vector<std::uint32_t> _calls;
+};
+}  // namespace detail
+
+template <class Description>
+[[nodiscard]] program compile(const Description& desc) {
+  program result;
+  detail::compiler c{result};
+  c.compile(desc, true);
+  c.finish();
+  return result;
+}
+
+}  // namespace parsers::vm
+
+#endif  // GUARD_PARSERS_VM_HPP
@@ -0,0 +1,77 @@
+#include <parsers/allocations.hpp>
+#include <parsers/parsers.hpp>
+
+#include <gtest/gtest.h>
+
+#include <string_view>
+#include <vector>
+
+using namespace parsers::description;
+
+namespace {
+// What a vector of T goes through when growing to `size` elements one
+// element at a time, whatever the growth policy of the standard library.
+template <class T>
+parsers::allocation_count vector_growth(std::size_t size) {
+  parsers::allocation_count expected;
+  std::vector<T> values;
+  for (std::size_t i = 0; i < size; ++i) {
+    const auto capacity = values.capacity();
+    values.push_back(T{});
+    if (values.capacity() != capacity) {
+      ++expected.allocations;
+      expected.bytes += values.capacity() * sizeof(T);
+    }
+  }
+  return expected;
+}
+
+struct chain : recursive<alternative<sequence<character<'a'>, chain>,
+                                     character<'.'>>> {};
+}  // namespace
+
+TEST(Allocations, ShouldCountVectorGrowth) {
+  parsers::allocation_count count;
+  {
+    const parsers::count_allocations counting{count};
+    ASSERT_TRUE(parsers::parse(many{ascii::digit}, "1234567").has_value());
+  }
+  const auto expected = vector_growth<char>(7);
+  ASSERT_EQ(count.allocations, expected.allocations);
+  ASSERT_EQ(count.bytes, expected.bytes);
+}
+
+TEST(Allocations, ShouldCountRecursiveNodes) {
+  constexpr std::string_view input = "aaa.";
+  parsers::allocation_count count;
+  {
+    const parsers::count_allocations counting{count};
+    ASSERT_TRUE(parsers::parse(chain{}, input).has_value());
+  }
+  using node_t = parsers::interpreters::detail::recursive_pointer_type<
+      chain,
+      parsers::interpreters::object_parser,
+      std::string_view::const_iterator>;
+  ASSERT_EQ(count.allocations, 3);
+  ASSERT_EQ(count.bytes, 3 * sizeof(node_t));
+}
+
+TEST(Allocations, ShouldAddNestedScopesToTheEnclosingOne) {
+  parsers::allocation_count outer;
+  parsers::allocation_count inner;
+  {
+    const parsers::count_allocations counting_outer{outer};
+    ASSERT_TRUE(parsers::parse(many{ascii::digit}, "12").has_value());
+    {
+      const parsers::count_allocations counting_inner{inner};
+      ASSERT_TRUE(parsers::parse(many{ascii::digit}, "1234").has_value());
+    }
+  }
+  ASSERT_EQ(inner.allocations, vector_growth<char>(4).allocations);
+  ASSERT_EQ(outer.allocations,
+            vector_growth<char>(2).allocations + inner.allocations);
+
+  ASSERT_TRUE(parsers::parse(many{ascii::digit}, "12345").has_value());
+  ASSERT_EQ(outer.allocations,
+            vector_growth<char>(2).allocations + inner.allocations);
+}
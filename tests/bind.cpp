@@ -1,8 +1,13 @@
 #include <cstddef>
 #include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
 #include <parsers/parsers.hpp>
 
 #include <parsers/description/bind.hpp>
+#include <parsers/description/cached_bind.hpp>
 
 #include <gtest/gtest.h>
 
@@ -98,6 +103,9 @@ TEST(Bind, ShouldWorkUnchangedWithMatcher) {
   static_assert(parsers::match(_3, "test tset"));
   static_assert(parsers::match(_3, "palindrome emordnilap"));
   static_assert(!parsers::match(_3, "fail fail"));
+  static_assert(parsers::match(_1 | 'x'_c, "3aaa"));
+  static_assert(parsers::match(_1 | 'x'_c, "x"));
+  static_assert(parsers::match(many{_1}, "1a2aa"));
 }
 
 template <class P, class T>
@@ -151,4 +159,104 @@ TEST(Bind, ObjectParserShouldWork) {
   for (std::size_t s = 0; s < 3; ++s) {
     ASSERT_EQ(r2[s], expected[s]);
   }
-}
\ No newline at end of file
+}
+namespace example {
+struct counting {
+  int* calls;
+
+  constexpr auto operator()(char c) const noexcept {
+    ++*calls;
+    return next_char(c);
+  }
+  constexpr auto operator()(int n) const noexcept {
+    ++*calls;
+    return n_char{'a'}(n);
+  }
+};
+}  // namespace example
+
+TEST(Bind, CachedBindShouldBuildEachParserOnce) {
+  using namespace example;
+  using namespace std::literals::string_view_literals;
+
+  int calls = 0;
+  const auto plain =
+      parsers::parse(many{bind{any, counting{&calls}}}, "abababcd"sv);
+  ASSERT_EQ(calls, 4);
+  calls = 0;
+  const auto cached =
+      parsers::parse(many{cached_bind{any, counting{&calls}}}, "abababcd"sv);
+  ASSERT_EQ(calls, 2);
+  ASSERT_TRUE(cached.has_value());
+  ASSERT_EQ(*cached, *plain);
+  ASSERT_EQ(*cached, (std::vector<char>{'b', 'b', 'b', 'd'}));
+
+  calls = 0;
+  const auto counts =
+      many{cached_bind{ascii::digit / to_int, counting{&calls}}};
+  const auto r = parsers::parse(counts, "2aa3aaa2aa1a3aaa"sv);
+  ASSERT_TRUE(r.has_value());
+  ASSERT_EQ(r->size(), 5);
+  ASSERT_EQ(r->at(1).size(), 3);
+  ASSERT_EQ(calls, 3);
+  ASSERT_TRUE(parsers::match_full(counts, "2aa3aaa2aa1a3aaa"sv));
+  ASSERT_FALSE(parsers::match_full(counts, "2aa3aa"sv));
+}
+
+TEST(Bind, CachedBindCopiesShouldStartWithAnEmptyCache) {
+  using namespace example;
+  using namespace std::literals::string_view_literals;
+
+  int calls = 0;
+  const auto parser =
+      parsers::interpreters::make_parser<parsers::interpreters::object_parser>(
+          cached_bind{any, counting{&calls}});
+  constexpr auto input = "ab"sv;
+  ASSERT_TRUE(parser(input.begin(), input.end()).has_value());
+  ASSERT_TRUE(parser(input.begin(), input.end()).has_value());
+  ASSERT_EQ(calls, 1);
+
+  const auto copy = parser;
+  ASSERT_TRUE(copy(input.begin(), input.end()).has_value());
+  ASSERT_EQ(calls, 2);
+  // Other iterators use a cache of their own, the first one being kept.
+  const std::string other{input};
+  ASSERT_TRUE(parser(other.begin(), other.end()).has_value());
+  ASSERT_TRUE(parser(input.begin(), input.end()).has_value());
+  ASSERT_EQ(calls, 2);
+}
+
+namespace example {
+// As many digits as letters in the word.
+struct as_many_digits {
+  int* calls;
+
+  template <class R>
+  constexpr auto operator()(const R& word) const noexcept {
+    ++*calls;
+    return at_least{static_cast<std::size_t>(word.end() - word.begin()),
+                    ascii::digit};
+  }
+};
+}  // namespace example
+
+TEST(Bind, CachedBindShouldNotKeepValuesReferringToTheInput) {
+  using namespace example;
+
+  static_assert(is_cacheable_value_v<int>);
+  static_assert(!is_cacheable_value_v<
+                parsers::range<const char*, const char*>>);
+
+  int calls = 0;
+  const auto parser = parsers::prepare(
+      many{cached_bind{as_range<many1<ascii::alpha_t>>{},
+                       as_many_digits{&calls}}});
+  for (int i = 0; i < 3; ++i) {
+    // Each input is freed before the next one is parsed.
+    const auto input = std::make_unique<std::string>("ab12abcd1234");
+    const auto r = parser(*input);
+    ASSERT_TRUE(r.has_value());
+    ASSERT_EQ(r.value().second.size(), 2);
+  }
+  ASSERT_EQ(calls, 6);
+}
@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+#include <parsers/allocations.hpp>
+#include <parsers/parsers.hpp>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace parsers::description;
+using namespace parsers::dsl;
+using namespace std::literals::string_view_literals;
+
+namespace {
+struct to_count {
+  constexpr int operator()(char c) const noexcept { return c - '0'; }
+};
+struct to_size {
+  template <class It>
+  constexpr std::size_t operator()(It beg, It end) const noexcept {
+    std::size_t acc = 0;
+    for (; beg != end; ++beg) {
+      acc = acc * 10 + static_cast<std::size_t>(*beg - '0');
+    }
+    return acc;
+  }
+};
+}  // namespace
+
+TEST(BoundedRange, ShouldStopAtTheMaximum) {
+  using digits = between<2, 4, ascii::digit_t>;
+  static_assert(!parsers::match(digits{}, "1"));
+  static_assert(parsers::match_length(digits{}, "12a") == 2);
+  static_assert(parsers::match_length(digits{}, "123456") == 4);
+
+  const auto r = parsers::parse(sequence{digits{}, many{ascii::digit}},
+                                "123456"sv);
+  ASSERT_TRUE(r.has_value());
+  ASSERT_EQ(std::get<0>(*r), (std::vector<char>{'1', '2', '3', '4'}));
+  ASSERT_EQ(std::get<1>(*r), (std::vector<char>{'5', '6'}));
+
+  const auto dynamic = bounded_range{1, 2, ascii::alpha};
+  ASSERT_EQ(parsers::match_length(dynamic, "abc"sv), 2);
+  ASSERT_FALSE(parsers::match(dynamic, "1"sv));
+}
+
+TEST(BoundedRange, ShouldRepeatExactly) {
+  static_assert(parsers::match_length(repeat_n<3, ascii::digit_t>{}, "12345") ==
+                3);
+  static_assert(!parsers::match(repeat_n<3, ascii::digit_t>{}, "12a"));
+  static_assert(parsers::match(repeat_n<0, ascii::digit_t>{}, "a"));
+  static_assert(parsers::match_length(repeat_n<12, ascii::digit_t>{},
+                                      "1234567890123") == 12);
+
+  const auto three = repeat{3, ascii::digit};
+  ASSERT_EQ(parsers::match_length(three, "12345"sv), 3);
+  ASSERT_FALSE(parsers::match(three, "12"sv));
+  const auto r = parsers::parse(three, "12345"sv);
+  ASSERT_TRUE(r.has_value());
+  ASSERT_EQ(*r, (std::vector<char>{'1', '2', '3'}));
+  ASSERT_EQ(*parsers::parse(repeat_n<3, ascii::digit_t>{}, "12345"sv), *r);
+}
+
+TEST(BoundedRange, ShouldReserveTheElementsOnce) {
+  const std::string input(100, 'x');
+  parsers::allocation_count count;
+  {
+    parsers::count_allocations counting{count};
+    ASSERT_EQ(parsers::parse(repeat{40, any}, input)->size(), 40);
+    ASSERT_EQ(parsers::parse(between<10, 60, any_t>{}, input)->size(), 60);
+  }
+  ASSERT_EQ(count.allocations, 2);
+  ASSERT_EQ(count.bytes, 100);
+
+  // Above 64 elements, only the minimum is reserved.
+  parsers::allocation_count above;
+  {
+    parsers::count_allocations counting{above};
+    ASSERT_EQ(parsers::parse(between<90, 200, any_t>{}, input)->size(), 100);
+  }
+  ASSERT_EQ(above.allocations, 2);
+
+  ASSERT_EQ(parsers::parse_two_phase(between<10, 60, any_t>{}, input)->size(),
+            60);
+}
+
+TEST(BoundedRange, ShouldReadTheCountFirst) {
+  const auto letters = counted{ascii::digit / to_count{}, ascii::alpha};
+  ASSERT_EQ(parsers::match_length(letters, "3abcd"sv), 4);
+  ASSERT_FALSE(parsers::match(letters, "3ab"sv));
+  const auto r = parsers::parse(letters, "3abcd"sv);
+  ASSERT_TRUE(r.has_value());
+  ASSERT_EQ(*r, (std::vector<char>{'a', 'b', 'c'}));
+
+  // A single byte count is unsigned.
+  std::string binary(1, static_cast<char>(200));
+  binary += std::string(200, 'x');
+  const auto bytes = parsers::parse(counted{any, any}, binary);
+  ASSERT_TRUE(bytes.has_value());
+  ASSERT_EQ(bytes->size(), 200);
+}
+
+TEST(BoundedRange, ShouldNotTrustTheCountBeforeParsing) {
+  const auto triples =
+      counted{build{many1<ascii::digit_t>{}, to_size{}},
+              sequence{ascii::alpha, ascii::alpha, ascii::alpha}};
+  constexpr auto input = "99999999999999abc"sv;
+  ASSERT_FALSE(parsers::parse(triples, input).has_value());
+  ASSERT_FALSE(parsers::match(triples, input));
+
+  // The vector still grows past what was reserved.
+  std::string many(100, 'a');
+  ASSERT_EQ(parsers::parse(counted{build{many1<ascii::digit_t>{}, to_size{}},
+                                   ascii::alpha},
+                           "100" + many)
+                ->size(),
+            100);
+}
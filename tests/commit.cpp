@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+#include <parsers/parsers.hpp>
+
+#include <string_view>
+#include <vector>
+
+using namespace parsers::description;
+using namespace parsers::dsl;
+using namespace std::literals::string_view_literals;
+
+namespace {
+using key = sequence<character<'k'>, character<'='>>;
+using value = many1<ascii::digit_t>;
+using entry = sequence<key, commit<value>>;
+using fallback = sequence<character<'k'>, many<ascii::alpha_t>>;
+
+struct list;
+using element = alternative<value, list>;
+struct list : recursive<sequence<character<'['>,
+                                 many<sequence<element, many<character<','>>>>,
+                                 commit<character<']'>>>> {};
+
+struct committing_matcher : parsers::interpreters::matcher {
+  static std::vector<std::ptrdiff_t>& positions() {
+    static std::vector<std::ptrdiff_t> p;
+    return p;
+  }
+  static const char* start;
+
+  template <class D, class It>
+  static void commit([[maybe_unused]] parsers::type_t<D>, It position) {
+    positions().push_back(position - start);
+  }
+};
+const char* committing_matcher::start = nullptr;
+}  // namespace
+
+TEST(Commit, ShouldNotTryOtherBranchesAfterACommittedFailure) {
+  using choice = alternative<entry, fallback>;
+  ASSERT_TRUE(parsers::match(choice{}, "k=12"sv));
+  ASSERT_TRUE(parsers::match(choice{}, "kab"sv));
+  ASSERT_FALSE(parsers::match(choice{}, "k=ab"sv));
+  ASSERT_FALSE(parsers::parse_range(choice{}, "k=ab"sv).has_value());
+  ASSERT_FALSE(parsers::parse(choice{}, "k=ab"sv).has_value());
+
+  using uncommitted = alternative<sequence<key, value>, fallback>;
+  ASSERT_TRUE(parsers::match(uncommitted{}, "k=ab"sv));
+}
+
+TEST(Commit, ShouldOnlyAffectTheClosestChoice) {
+  using inner = alternative<entry, fallback>;
+  using outer = alternative<inner, sequence<character<'k'>, character<'='>,
+                                            ascii::alpha_t>>;
+  ASSERT_TRUE(parsers::match(outer{}, "k=a"sv));
+  ASSERT_TRUE(parsers::parse(outer{}, "k=a"sv).has_value());
+}
+
+TEST(Commit, ShouldFailRepetitionsOnCommittedFailures) {
+  using entries = many<sequence<entry, character<';'>>>;
+  ASSERT_EQ(parsers::match_length(entries{}, "k=1;k=2;x"sv), 8);
+  ASSERT_FALSE(parsers::match(entries{}, "k=1;k=x;"sv));
+  ASSERT_FALSE(parsers::parse(entries{}, "k=1;k=x;"sv).has_value());
+
+  const auto r = parsers::parse(entries{}, "k=1;k=2;"sv);
+  ASSERT_TRUE(r.has_value());
+  ASSERT_EQ(r->size(), 2);
+  ASSERT_EQ(std::get<1>(std::get<0>(r->at(1))), std::vector<char>{'2'});
+}
+
+TEST(Commit, ShouldMakeFailuresAfterTheCutFatal) {
+  using choice =
+      alternative<sequence<key, commit<value>, character<';'>>, fallback>;
+  ASSERT_TRUE(parsers::match(choice{}, "k=1;"sv));
+  ASSERT_FALSE(parsers::match(choice{}, "k=1x"sv));
+  ASSERT_FALSE(parsers::parse_range(choice{}, "k=1x"sv).has_value());
+  ASSERT_FALSE(parsers::parse(choice{}, "k=1x"sv).has_value());
+
+  using entries = many<sequence<key, commit<value>, character<';'>>>;
+  ASSERT_FALSE(parsers::match(entries{}, "k=1;k=2x"sv));
+  ASSERT_FALSE(parsers::parse(entries{}, "k=1;k=2x"sv).has_value());
+}
+
+TEST(Commit, ShouldNotOutliveTheClosestChoice) {
+  // The inner choice commits and succeeds, the outer one still backtracks
+  // when the rest of its branch fails.
+  using inner = alternative<entry, fallback>;
+  using outer = alternative<sequence<inner, character<';'>>,
+                            sequence<character<'k'>, any_t, any_t, any_t>>;
+  ASSERT_TRUE(parsers::match(outer{}, "k=1x"sv));
+  ASSERT_TRUE(parsers::parse_range(outer{}, "k=1x"sv).has_value());
+  ASSERT_TRUE(parsers::parse(outer{}, "k=1x"sv).has_value());
+}
+
+TEST(Commit, ShouldWorkInRecursiveDescriptions) {
+  static_assert(may_commit_v<list>);
+  static_assert(!may_commit_v<sequence<key, value>>);
+  ASSERT_TRUE(parsers::match(list{}, "[1,[2,3],[]]"sv));
+  ASSERT_FALSE(parsers::match(list{}, "[1,[2,3x],[]]"sv));
+  ASSERT_FALSE(parsers::parse(list{}, "[1,[2,3x],[]]"sv).has_value());
+}
+
+TEST(Commit, ShouldBeAvailableInTheDsl) {
+  constexpr auto call = ("f"_s > '(') | ("f"_s & 'x');
+  ASSERT_TRUE(parsers::match(call, "f("sv));
+  ASSERT_FALSE(parsers::match(call, "fx"sv));
+  ASSERT_TRUE(parsers::match(("g"_s & '(') | ("g"_s & 'x'), "gx"sv));
+
+  // `>` binds tighter than `&`, the cut still covers what follows.
+  constexpr auto parens = ("f"_s > '(' & ')') | ("f"_s & '(' & 'x');
+  ASSERT_TRUE(parsers::match(parens, "f()"sv));
+  ASSERT_FALSE(parsers::match(parens, "f(x"sv));
+  ASSERT_TRUE(parsers::match(("f"_s & '(' & ')') | ("f"_s & '(' & 'x'),
+                             "f(x"sv));
+}
+
+TEST(Commit, ShouldTellInterpretersWhereTheCutIs) {
+  constexpr auto input = "k=12"sv;
+  committing_matcher::start = input.data();
+  committing_matcher::positions().clear();
+  const auto parser =
+      parsers::interpreters::make_parser<committing_matcher>(entry{});
+  ASSERT_TRUE(parser(input.data(), input.data() + input.size()));
+  ASSERT_EQ(committing_matcher::positions(), std::vector<std::ptrdiff_t>{2});
+}
@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+#include <parsers/parsers.hpp>
+
+#include <forward_list>
+#include <string>
+#include <string_view>
+
+using parsers::count;
+using parsers::count_all;
+using namespace parsers::description;
+using namespace std::literals::string_literals;
+using namespace std::literals::string_view_literals;
+
+TEST(Count, ShouldCountLeadingRepetitions) {
+  constexpr character<'a'> a;
+  static_assert(count(a, "aaab"sv) == 3);
+  static_assert(count(a, "baaa"sv) == 0);
+  static_assert(count(ascii::digit, "0123x45"sv) == 4);
+  ASSERT_EQ(count(a, ""s), 0);
+  ASSERT_EQ(count(a, std::string(100, 'a')), 100);
+  ASSERT_EQ(count(a, std::string(37, 'a') + "b" + std::string(40, 'a')), 37);
+}
+
+TEST(Count, ShouldAgreeWithMany) {
+  using word = sequence<many1<ascii::alpha_t>, discard<character<' '>>>;
+  const auto input = "some words in a row 42 then more"s;
+  const auto parsed = parsers::parse(many<word>{}, input);
+  ASSERT_TRUE(parsed.has_value());
+  ASSERT_EQ(count(word{}, input), parsed->size());
+  ASSERT_EQ(count(word{}, input), 5);
+}
+
+TEST(Count, ShouldCountAllOccurrences) {
+  constexpr character<','> comma;
+  static_assert(count_all(comma, "a,b,,c,"sv) == 4);
+  static_assert(count_all(ascii::digit, "a1b22c333"sv) == 6);
+  ASSERT_EQ(count_all(comma, std::string(1000, ',')), 1000);
+  ASSERT_EQ(count_all(comma, ""s), 0);
+
+  using number = many1<ascii::digit_t>;
+  ASSERT_EQ(count_all(number{}, "a1b22c333"s), 3);
+  ASSERT_EQ(count_all(sequence<character<'a'>, character<'b'>, character<'a'>>{}, "ababababa"s), 2);
+}
+
+TEST(Count, ShouldNotCountEmptyMatches) {
+  using as = many<character<'a'>>;
+  ASSERT_EQ(count(as{}, "aab"s), 1);
+  ASSERT_EQ(count(as{}, "baa"s), 0);
+  ASSERT_EQ(count_all(as{}, "aabaa"s), 2);
+}
+
+TEST(Count, ShouldWorkOnNonContiguousInputs) {
+  const std::forward_list<char> input{'x', 'x', 'y', 'x'};
+  ASSERT_EQ(count(character<'x'>{}, input), 2);
+  ASSERT_EQ(count_all(character<'x'>{}, input), 3);
+  ASSERT_EQ(count_all(sequence<character<'x'>, character<'y'>>{}, input), 1);
+}
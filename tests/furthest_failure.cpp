@@ -0,0 +1,100 @@
+#include <parsers/parsers.hpp>
+#include <parsers/furthest_failure.hpp>
+
+#include <gtest/gtest.h>
+
+#include <string_view>
+
+using namespace parsers::description;
+using namespace std::literals::string_view_literals;
+
+namespace {
+using number = many1<ascii::digit_t>;
+using pair = sequence<number, discard<character<','>>, number>;
+
+template <class Interpreter, class D>
+parsers::furthest_failure furthest(const D& description,
+                                   std::string_view input) {
+  parsers::furthest_failure failure;
+  const auto parser =
+      parsers::make_failure_tracking_parser<Interpreter>(description, failure);
+  static_cast<void>(parser(input.begin(), input.end()));
+  return failure;
+}
+}  // namespace
+
+TEST(FurthestFailure, ShouldFindTheFurthestFailingTerminal) {
+  constexpr auto input = "12,34;"sv;
+  const auto failure = furthest<parsers::interpreters::range_parser>(
+      sequence<pair, end_t>{}, input);
+  ASSERT_FALSE(failure.empty());
+  ASSERT_EQ(failure.offset(input.size()), 5);
+  ASSERT_TRUE(failure.expects_end());
+  ASSERT_EQ(failure.expected().size(), 10);
+  ASSERT_TRUE(failure.expected().contains('7'));
+  ASSERT_FALSE(failure.expected().contains(';'));
+}
+
+TEST(FurthestFailure, ShouldSeeTerminalsInsideModifiers) {
+  constexpr auto input = "12;34"sv;
+  for (const auto& failure :
+       {furthest<parsers::interpreters::object_parser>(pair{}, input),
+        furthest<parsers::interpreters::range_parser>(pair{}, input),
+        furthest<parsers::interpreters::matcher>(pair{}, input)}) {
+    ASSERT_EQ(failure.offset(input.size()), 2);
+    ASSERT_TRUE(failure.expected().contains(','));
+    ASSERT_TRUE(failure.expected().contains('0'));
+    ASSERT_EQ(failure.expected().size(), 11);
+    ASSERT_FALSE(failure.expects_end());
+  }
+}
+
+TEST(FurthestFailure, ShouldMergeWhatWasExpectedAtTheSamePosition) {
+  const auto description =
+      alternative{static_string{"let"}, character<'x'>{}, character{'y'}};
+  const auto failure =
+      furthest<parsers::interpreters::matcher>(description, "z"sv);
+  ASSERT_EQ(failure.offset(1), 0);
+  ASSERT_EQ(failure.expected().size(), 3);
+  ASSERT_TRUE(failure.expected().contains('l'));
+  ASSERT_TRUE(failure.expected().contains('x'));
+  ASSERT_TRUE(failure.expected().contains('y'));
+}
+
+TEST(FurthestFailure, ShouldRecordWhereAStringStoppedMatching) {
+  const auto failure = furthest<parsers::interpreters::range_parser>(
+      static_string{"let"}, "lex"sv);
+  ASSERT_EQ(failure.offset(3), 2);
+  ASSERT_EQ(failure.expected().size(), 1);
+  ASSERT_TRUE(failure.expected().contains('t'));
+  ASSERT_FALSE(failure.expects_end());
+
+  const auto truncated =
+      furthest<parsers::interpreters::matcher>(static_string{"let"}, "le"sv);
+  ASSERT_EQ(truncated.offset(2), 2);
+  ASSERT_TRUE(truncated.expected().contains('t'));
+}
+
+TEST(FurthestFailure, ShouldProduceTheSameResults) {
+  parsers::furthest_failure failure;
+  constexpr auto input = "12,34"sv;
+  const auto tracked =
+      parsers::make_failure_tracking_parser<parsers::interpreters::object_parser>(
+          pair{}, failure);
+  const auto plain =
+      parsers::interpreters::make_parser<parsers::interpreters::object_parser>(
+          pair{});
+  ASSERT_EQ(*tracked(input.begin(), input.end()),
+            *plain(input.begin(), input.end()));
+  // The first number stopped on the comma.
+  ASSERT_EQ(failure.offset(input.size()), 2);
+  ASSERT_EQ(failure.expected().size(), 10);
+
+  parsers::furthest_failure untouched;
+  const auto disabled = parsers::make_failure_tracking_parser<
+      parsers::interpreters::range_parser,
+      false>(sequence<pair, end_t>{}, untouched);
+  constexpr auto invalid = "12,34;"sv;
+  ASSERT_FALSE(disabled(invalid.begin(), invalid.end()).has_value());
+  ASSERT_TRUE(untouched.empty());
+}
@@ -0,0 +1,105 @@
+#include <parsers/generator.hpp>
+#include <parsers/parsers.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std::literals::string_literals;
+using namespace parsers::description;
+
+namespace {
+using record =
+    sequence<as_range<many1<ascii::alpha_t>>, discard<character<';'>>>;
+
+std::size_t allocations = 0;
+
+template <class T>
+struct counting_allocator {
+  using value_type = T;
+
+  counting_allocator() noexcept = default;
+  template <class U>
+  counting_allocator(
+      [[maybe_unused]] const counting_allocator<U>& other) noexcept {}
+
+  T* allocate(std::size_t n) {
+    ++allocations;
+    return std::allocator<T>{}.allocate(n);
+  }
+  void deallocate(T* ptr, std::size_t n) noexcept {
+    std::allocator<T>{}.deallocate(ptr, n);
+  }
+
+  template <class U>
+  friend bool operator==(const counting_allocator&,
+                         const counting_allocator<U>&) noexcept {
+    return true;
+  }
+};
+}  // namespace
+
+TEST(Generator, ShouldYieldEachElement) {
+  const auto input = "ab;cde;f;?"s;
+  std::vector<std::string> seen;
+  for (const auto& r : parsers::generate(many<record>{}, input)) {
+    seen.emplace_back(r.begin(), r.end());
+  }
+  ASSERT_EQ(seen, (std::vector<std::string>{"ab", "cde", "f"}));
+}
+
+TEST(Generator, ShouldStopWhenTheConsumerStops) {
+  const auto input = "a;b;c;d;"s;
+  std::size_t taken = 0;
+  for (auto&& r : parsers::generate(many1<record>{}, input)) {
+    static_cast<void>(r);
+    if (++taken == 2) {
+      break;
+    }
+  }
+  ASSERT_EQ(taken, 2);
+}
+
+TEST(Generator, ShouldAllocateTheFrameWithTheGivenAllocator) {
+  allocations = 0;
+  const auto input = "a;b;"s;
+  std::size_t count = 0;
+  for (auto&& r : parsers::generate(std::allocator_arg,
+                                    counting_allocator<std::byte>{},
+                                    many<record>{},
+                                    input)) {
+    static_cast<void>(r);
+    ++count;
+  }
+  ASSERT_EQ(count, 2);
+  ASSERT_EQ(allocations, 1);
+}
+
+TEST(Generator, ShouldFailBelowTheMinimum) {
+  const auto input = "a;b;?"s;
+  auto enough = parsers::generate(at_least_n<2, record>{}, input);
+  std::size_t count = 0;
+  for (auto&& r : enough) {
+    static_cast<void>(r);
+    ++count;
+  }
+  ASSERT_EQ(count, 2);
+  ASSERT_FALSE(enough.failed());
+
+  auto short_input = parsers::generate(at_least_n<3, record>{}, input);
+  count = 0;
+  for (auto&& r : short_input) {
+    static_cast<void>(r);
+    ++count;
+  }
+  ASSERT_EQ(count, 2);
+  ASSERT_TRUE(short_input.failed());
+
+  const auto empty = ""s;
+  auto none = parsers::generate(many1<record>{}, empty);
+  ASSERT_TRUE(none.begin() == none.end());
+  ASSERT_TRUE(none.failed());
+}
@@ -0,0 +1,98 @@
+#include <parsers/parsers.hpp>
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+using namespace std::literals::string_literals;
+using namespace parsers::description;
+
+namespace {
+using record = sequence<as_range<many1<ascii::alpha_t>>, discard<character<';'>>>;
+}
+
+TEST(LazyMany, ShouldParseElementsOnDemand) {
+  const auto input = "ab;cde;f;"s;
+  auto r = parsers::parse(lazy_many<record>{}, input);
+  ASSERT_TRUE(r.has_value());
+  auto& elements = r.value();
+  auto it = elements.begin();
+  ASSERT_NE(it, elements.end());
+  ASSERT_EQ(*it, "ab");
+  ++it;
+  ASSERT_EQ(*it, "cde");
+  ASSERT_EQ(it.base(), input.begin() + 7);
+  ++it;
+  ASSERT_EQ(*it, "f");
+  ++it;
+  ASSERT_EQ(it, elements.end());
+}
+
+TEST(LazyMany, ShouldStopAtTheFirstFailure) {
+  const auto input = "ab;c?;d;"s;
+  std::vector<std::string> seen;
+  auto r = parsers::parse(lazy_many<record>{}, input);
+  ASSERT_TRUE(r.has_value());
+  for (const auto& e : r.value()) {
+    seen.emplace_back(e.begin(), e.end());
+  }
+  ASSERT_EQ(seen, (std::vector<std::string>{"ab"}));
+}
+
+TEST(LazyMany, ShouldComposeWithSequences) {
+  using header = sequence<as_range<many1<ascii::digit_t>>,
+                          discard<character<':'>>>;
+  const auto input = "3:ab;cd;ef;gh;"s;
+  auto r = parsers::parse(sequence<header, lazy_many<record>>{}, input);
+  ASSERT_TRUE(r.has_value());
+  auto& [count, body] = r.value();
+  ASSERT_EQ(count, "3");
+  std::size_t taken = 0;
+  for (auto it = body.begin(); it != body.end() && taken < 2; ++it) {
+    ++taken;
+  }
+  ASSERT_EQ(taken, 2);
+
+  ASSERT_EQ(parsers::match_length(sequence<header, lazy_many<record>>{}, input),
+            input.size());
+}
+
+TEST(LazyMany, ShouldBeCheckedEagerlyWithoutObjects) {
+  ASSERT_FALSE(parsers::match_full(lazy_many<record>{}, "ab;??"s));
+  ASSERT_TRUE(parsers::match_full(lazy_many<record>{}, "ab;cd;"s));
+  ASSERT_EQ(parsers::match_length(lazy_many<record>{}, "ab;c?;d;"s), 3);
+
+  const auto input = "ab;??"s;
+  const auto range = parsers::parse_range(lazy_many<record>{}, input);
+  ASSERT_TRUE(range.has_value());
+  ASSERT_EQ(range->second, input.begin() + 3);
+  ASSERT_FALSE(
+      parsers::parse_range(sequence<lazy_many<record>, end_t>{}, input)
+          .has_value());
+}
+
+TEST(LazyMany, ShouldTellWhereTheIterationStopped) {
+  using records = sequence<lazy_many<record>, end_t>;
+
+  // The object parser consumes the rest of the input without looking at it.
+  const auto input = "ab;??"s;
+  auto r = parsers::parse(records{}, input);
+  ASSERT_TRUE(r.has_value());
+  auto it = r.value().begin();
+  for (; it != r.value().end(); ++it) {
+    ASSERT_FALSE(it.failed());
+  }
+  ASSERT_TRUE(it.failed());
+  ASSERT_EQ(it.base(), input.begin() + 3);
+
+  const auto valid = "ab;cd;"s;
+  auto v = parsers::parse(records{}, valid);
+  ASSERT_TRUE(v.has_value());
+  auto last = v.value().begin();
+  while (last != v.value().end()) {
+    ++last;
+  }
+  ASSERT_FALSE(last.failed());
+  ASSERT_EQ(last.base(), valid.end());
+}
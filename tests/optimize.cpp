@@ -0,0 +1,127 @@
+#include <parsers/parsers.hpp>
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <tuple>
+#include <type_traits>
+
+using namespace std::literals::string_literals;
+using namespace parsers::dsl;
+using namespace parsers::description;
+using parsers::interpreters::matcher;
+using parsers::interpreters::object_parser;
+using parsers::interpreters::range_parser;
+
+TEST(Optimize, ShouldMergeCharactersForMatcher) {
+  constexpr auto abc =
+      character<'a'>{} & (character<'b'>{} & ~character<'c'>{});
+  using optimized_t = decltype(parsers::optimize<matcher>(abc));
+  static_assert(std::is_same_v<optimized_t, static_string<char>>);
+
+  constexpr auto s = parsers::optimize<matcher>(abc);
+  constexpr const char* input = "abcd";
+  static_assert(s(input, input + 4) == input + 3);
+  static_assert(parsers::match(abc, "abc"));
+  static_assert(!parsers::match(abc, "abd"));
+}
+
+TEST(Optimize, ShouldFlattenSequencesForMatcher) {
+  constexpr auto bs = many{character<'b'>{}};
+  constexpr auto desc = sequence{
+      character<'a'>{}, bs, both{character<'c'>{}, character<'d'>{}}};
+  using optimized_t = decltype(parsers::optimize<matcher>(desc));
+  static_assert(std::is_same_v<optimized_t,
+                               sequence<character<'a'>,
+                                        std::decay_t<decltype(bs)>,
+                                        static_string<char>>>);
+  static_assert(parsers::match(desc, "abbbcd"));
+  static_assert(!parsers::match(desc, "abbbc"));
+}
+
+TEST(Optimize, ShouldFlattenAlternativesForMatcher) {
+  constexpr auto desc = character<'a'>{} | (character<'b'>{} | ascii::digit);
+  using optimized_t = decltype(parsers::optimize<matcher>(desc));
+  static_assert(std::is_same_v<
+                optimized_t,
+                alternative<character<'a'>, character<'b'>, ascii::digit_t>>);
+  static_assert(parsers::match(desc, "7"));
+  static_assert(!parsers::match(desc, "c"));
+}
+
+TEST(Optimize, ShouldOnlyMergeAlternativesForRanges) {
+  constexpr auto desc = character<'a'>{} & (character<'b'>{} & ~ascii::digit);
+  using optimized_t =
+      std::decay_t<decltype(parsers::optimize<range_parser>(desc))>;
+  static_assert(std::is_same_v<optimized_t, std::decay_t<decltype(desc)>>);
+
+  constexpr auto alt = character<'a'>{} | (character<'b'>{} | ascii::digit);
+  using alternative_t =
+      std::decay_t<decltype(parsers::optimize<range_parser>(alt))>;
+  static_assert(std::is_same_v<
+                alternative_t,
+                alternative<character<'a'>, character<'b'>, ascii::digit_t>>);
+}
+
+TEST(Optimize, ShouldPreserveObjectResults) {
+  constexpr auto as = many{character<'a'>{}};
+  constexpr auto single = sequence{as};
+  using single_t = std::decay_t<decltype(parsers::optimize(single))>;
+  static_assert(std::is_same_v<single_t, std::decay_t<decltype(single)>>);
+
+  constexpr auto desc = ~character<'('>{} & ~character<' '>{} & ascii::digit &
+                        (~character<' '>{} & ~character<')'>{});
+  using optimized_t =
+      std::decay_t<decltype(parsers::optimize<object_parser>(desc))>;
+  static_assert(std::is_same_v<optimized_t, std::decay_t<decltype(desc)>>);
+
+  const auto r = parsers::parse(desc, "( 4 )"s);
+  ASSERT_TRUE(r.has_value());
+  static_assert(std::is_same_v<std::decay_t<decltype(r.value())>, char>);
+  ASSERT_EQ(r.value(), '4');
+  ASSERT_FALSE(parsers::parse(desc, "( 4)"s).has_value());
+}
+
+TEST(Optimize, ShouldUnwrapNestedDiscardsForObjects) {
+  using nested_t = discard<discard<ascii::digit_t>>;
+  using optimized_t =
+      std::decay_t<decltype(parsers::optimize<object_parser>(nested_t{}))>;
+  static_assert(std::is_same_v<optimized_t, discard<ascii::digit_t>>);
+}
+
+TEST(Optimize, ShouldKeepTuplesOfObjectSequences) {
+  constexpr auto desc = both{ascii::digit, both{ascii::digit, ascii::digit}};
+  using optimized_t = std::decay_t<decltype(parsers::optimize(desc))>;
+  static_assert(std::is_same_v<optimized_t, std::decay_t<decltype(desc)>>);
+
+  const auto r = parsers::parse(desc, "123"s);
+  ASSERT_TRUE(r.has_value());
+  ASSERT_EQ(std::get<0>(r.value()), '1');
+  ASSERT_EQ(std::get<1>(std::get<1>(r.value())), '3');
+}
+
+TEST(Optimize, ShouldKeepFailurePositions) {
+  const auto abd = "abd"s;
+  const auto r1 = parsers::parse_range(
+      character<'a'>{} & character<'b'>{} & character<'c'>{}, abd);
+  ASSERT_TRUE(r1.is_error());
+  ASSERT_EQ(r1.error() - abd.begin(), 2);
+
+  const auto aa = "aa"s;
+  const auto r2 = parsers::parse_range(
+      sequence{character<'a'>{},
+               sequence{character<'b'>{}, character<'c'>{}},
+               many{character<'0'>{}}},
+      aa);
+  ASSERT_TRUE(r2.is_error());
+  ASSERT_EQ(r2.error() - aa.begin(), 1);
+
+  const auto r3 = parsers::parse(
+      sequence{~character<'a'>{},
+               ~character<'b'>{},
+               ascii::digit,
+               ~(character<'x'>{} & character<'y'>{})},
+      aa);
+  ASSERT_TRUE(r3.is_error());
+  ASSERT_EQ(r3.error() - aa.begin(), 1);
+}
@@ -0,0 +1,145 @@
+#include <parsers/parsers.hpp>
+#include <parsers/pipeline.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace parsers::description;
+
+namespace {
+struct string_reader {
+  const std::string& input;
+  std::size_t position = 0;
+  std::size_t max_read;
+
+  std::size_t operator()(char* buffer, std::size_t size) {
+    const auto n =
+        std::min({size, max_read, input.size() - position});
+    std::memcpy(buffer, input.data() + position, n);
+    position += n;
+    return n;
+  }
+};
+
+constexpr auto to_int = [](auto beg, auto end) {
+  int acc = 0;
+  for (; beg != end; ++beg) {
+    acc = acc * 10 + (*beg - '0');
+  }
+  return acc;
+};
+constexpr auto integer = build{many1<ascii::digit_t>{}, to_int};
+}  // namespace
+
+TEST(SpscQueue, ShouldTransferValuesInOrder) {
+  dpsg::spsc_queue<int> queue{3};
+  ASSERT_EQ(queue.capacity(), 4);
+  std::thread producer{[&] {
+    for (int i = 0; i < 10000; ++i) {
+      while (!queue.try_push(i)) {
+        std::this_thread::yield();
+      }
+    }
+  }};
+  for (int expected = 0; expected < 10000;) {
+    if (auto i = queue.try_pop()) {
+      ASSERT_EQ(*i, expected);
+      ++expected;
+    }
+  }
+  producer.join();
+  ASSERT_FALSE(queue.try_pop().has_value());
+}
+
+TEST(Pipeline, ShouldDeliverResultsInOrder) {
+  std::string input;
+  for (int i = 0; i < 5000; ++i) {
+    input += std::to_string(i);
+    input += i % 1000 == 999 ? "\nnot a number\n" : "\n";
+  }
+  input += "5000";
+
+  parsers::pipeline p{integer,
+                      parsers::pipeline_options{3, 64, 2, '\n'}};
+  std::vector<int> results;
+  const auto stats = p.run(string_reader{input, 0, 37},
+                           [&](int i) { results.push_back(i); });
+
+  ASSERT_EQ(results.size(), 5001);
+  for (int i = 0; i <= 5000; ++i) {
+    ASSERT_EQ(results[static_cast<std::size_t>(i)], i);
+  }
+  ASSERT_EQ(stats.records, 5001);
+  ASSERT_EQ(stats.failures, 5);
+  ASSERT_EQ(stats.bytes_read, input.size());
+  ASSERT_GT(stats.chunks, 1);
+}
+
+TEST(Pipeline, ShouldGiveEachThreadItsOwnCachedBind) {
+  const auto runs = cached_bind{ascii::alpha, [](char c) {
+                                  return many{character{c}};
+                                }};
+  std::string input;
+  for (int i = 0; i < 4000; ++i) {
+    input += std::string(static_cast<std::size_t>(i % 7 + 1),
+                         static_cast<char>('a' + i % 26));
+    input += '\n';
+  }
+
+  parsers::pipeline p{runs, parsers::pipeline_options{4, 64, 2, '\n'}};
+  std::vector<std::size_t> lengths;
+  const auto stats =
+      p.run(string_reader{input, 0, 53},
+            [&](std::vector<char> v) { lengths.push_back(v.size()); });
+
+  ASSERT_EQ(stats.failures, 0);
+  ASSERT_EQ(lengths.size(), 4000);
+  for (std::size_t i = 0; i < lengths.size(); ++i) {
+    ASSERT_EQ(lengths[i], i % 7);
+  }
+}
+
+TEST(Pipeline, ShouldJoinItsThreadsWhenAStageThrows) {
+  std::string input;
+  for (int i = 0; i < 5000; ++i) {
+    input += std::to_string(i);
+    input += '\n';
+  }
+
+  parsers::pipeline p{integer, parsers::pipeline_options{3, 64, 2, '\n'}};
+  int consumed = 0;
+  ASSERT_THROW(p.run(string_reader{input, 0, 37},
+                     [&](int i) {
+                       if (i == 100) {
+                         throw std::runtime_error{"consumer"};
+                       }
+                       ++consumed;
+                     }),
+               std::runtime_error);
+  ASSERT_EQ(consumed, 100);
+
+  auto throwing_reader = [read = std::size_t{0}](
+                                   char* buffer,
+                                   std::size_t size) mutable -> std::size_t {
+    if (read > 1000) {
+      throw std::runtime_error{"reader"};
+    }
+    for (std::size_t i = 0; i < size; ++i) {
+      buffer[i] = i % 2 == 0 ? '1' : '\n';
+    }
+    read += size;
+    return size;
+  };
+  ASSERT_THROW(p.run(throwing_reader, [](int) {}), std::runtime_error);
+
+  // The pipeline can run again afterwards.
+  std::vector<int> results;
+  p.run(string_reader{input, 0, 37}, [&](int i) { results.push_back(i); });
+  ASSERT_EQ(results.size(), 5000);
+}
@@ -0,0 +1,50 @@
+#include <parsers/parsers.hpp>
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+using namespace std::literals::string_literals;
+using namespace parsers::dsl;
+using namespace parsers::description;
+
+TEST(Prepared, ShouldBehaveLikeMakeParser) {
+  constexpr auto ab = parsers::prepare<parsers::interpreters::matcher>(
+      character<'a'>{} & many{character<'b'>{}});
+  constexpr const auto& input = "abbbc";
+  static_assert(ab(input).has_value());
+  static_assert(*ab(input) == input + 4);
+  static_assert(!ab("ba").has_value());
+
+  const auto r = parsers::prepare(many{character<'a'>{}})("aaab"s);
+  ASSERT_TRUE(r.has_value());
+  ASSERT_EQ(r.value().second.size(), 3);
+}
+
+TEST(Prepared, ParseBatchShouldParseEveryInput) {
+  const auto integer = parsers::prepare(many1{ascii::digit} / [](auto&& v) {
+    int acc = 0;
+    for (char c : v) {
+      acc = acc * 10 + (c - '0');
+    }
+    return acc;
+  });
+  const std::vector<std::string> inputs{"12", "x", "345", "6"};
+
+  using result_t = decltype(parsers::parse(many1{ascii::digit}, inputs[0]));
+  std::vector<dpsg::result<int, result_t::error_type>> out;
+  ASSERT_EQ(parsers::parse_batch(integer, inputs, out), 3);
+  ASSERT_EQ(out.size(), 4);
+  ASSERT_EQ(out[0].value(), 12);
+  ASSERT_TRUE(out[1].is_error());
+  ASSERT_EQ(out[2].value(), 345);
+  ASSERT_EQ(out[3].value(), 6);
+
+  const auto capacity = out.capacity();
+  const std::vector<std::string> second{"7", "8"};
+  ASSERT_EQ(parsers::parse_batch(integer, second, out), 2);
+  ASSERT_EQ(out.size(), 2);
+  ASSERT_EQ(out[1].value(), 8);
+  ASSERT_EQ(out.capacity(), capacity);
+}
@@ -0,0 +1,141 @@
+#include <parsers/parsers.hpp>
+#include <parsers/profiling.hpp>
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace parsers::description;
+
+struct parens
+    : recursive<sequence<character<'('>, many<parens>, character<')'>>> {};
+using prefixed = alternative<sequence<character<'a'>, parens>,
+                             sequence<character<'a'>, character<'b'>>>;
+
+const parsers::profile::node* find(const parsers::profile& prof,
+                                   std::size_t parent,
+                                   std::uint32_t rank) {
+  for (const auto& n : prof.nodes()) {
+    if (n.parent == parent && n.rank == rank) {
+      return &n;
+    }
+  }
+  return nullptr;
+}
+
+TEST(Profiling, ShouldCountInvocationsPerNode) {
+  parsers::profile prof;
+  const auto parser =
+      parsers::make_profiled_parser<parsers::interpreters::range_parser>(
+          prefixed{}, prof);
+  constexpr std::string_view input = "ab";
+  ASSERT_TRUE(parser(input.begin(), input.end()).has_value());
+  ASSERT_TRUE(parser(input.begin(), input.end()).has_value());
+
+  const auto* root = find(prof, parsers::profile::no_parent, 0);
+  ASSERT_NE(root, nullptr);
+  ASSERT_EQ(root->invocations, 2);
+  ASSERT_EQ(root->successes, 2);
+  ASSERT_EQ(root->bytes_consumed, 4);
+
+  const auto* first = find(prof, 0, 0);
+  ASSERT_NE(first, nullptr);
+  ASSERT_EQ(first->failures, 2);
+  ASSERT_EQ(first->bytes_rescanned, 2);
+
+  const auto* second = find(prof, 0, 1);
+  ASSERT_NE(second, nullptr);
+  ASSERT_EQ(second->successes, 2);
+  ASSERT_EQ(second->bytes_consumed, 4);
+  ASSERT_LE(first->time + second->time, root->time);
+}
+
+TEST(Profiling, ShouldFoldRecursiveCalls) {
+  parsers::profile prof;
+  const auto parser =
+      parsers::make_profiled_parser<parsers::interpreters::matcher>(parens{},
+                                                                    prof);
+  constexpr std::string_view shallow = "()";
+  constexpr std::string_view deep = "((((()))))";
+  ASSERT_TRUE(parser(shallow.begin(), shallow.end()));
+  const auto count = prof.nodes().size();
+  ASSERT_TRUE(parser(deep.begin(), deep.end()));
+  ASSERT_EQ(prof.nodes().size(), count);
+  ASSERT_GE(prof.nodes()[0].time, prof.nodes()[0].self_time);
+}
+
+TEST(Profiling, ShouldReportNodesAsJson) {
+  parsers::profile prof;
+  const auto parser =
+      parsers::make_profiled_parser<parsers::interpreters::object_parser>(
+          many{ascii::digit}, prof);
+  const std::string input = "123";
+  ASSERT_TRUE(parser(input.begin(), input.end()).has_value());
+  const auto json = prof.json();
+  ASSERT_EQ(json.front(), '[');
+  ASSERT_NE(json.find("\"parent\": null"), std::string::npos);
+  ASSERT_NE(json.find("\"bytes_consumed\": 3"), std::string::npos);
+  ASSERT_NE(prof.report().find("0:many"), std::string::npos);
+
+  prof.clear();
+  ASSERT_TRUE(prof.nodes().empty());
+}
+
+TEST(Profiling, ShouldCountAllocationsPerNode) {
+  parsers::profile prof;
+  const auto parser =
+      parsers::make_profiled_parser<parsers::interpreters::object_parser>(
+          sequence{many{ascii::digit}, character<','>{}, many{ascii::alpha}},
+          prof);
+  const std::string input = "12345,abc";
+  ASSERT_TRUE(parser(input.begin(), input.end()).has_value());
+
+  const auto growth = [](std::size_t size) {
+    parsers::allocation_count expected;
+    std::vector<char> values;
+    for (std::size_t i = 0; i < size; ++i) {
+      const auto capacity = values.capacity();
+      values.push_back('0');
+      if (values.capacity() != capacity) {
+        ++expected.allocations;
+        expected.bytes += values.capacity();
+      }
+    }
+    return expected;
+  };
+  const auto digits = growth(5);
+  const auto letters = growth(3);
+
+  const auto* root = find(prof, parsers::profile::no_parent, 0);
+  ASSERT_NE(root, nullptr);
+  ASSERT_EQ(root->allocations, digits.allocations + letters.allocations);
+  ASSERT_EQ(root->allocated_bytes, digits.bytes + letters.bytes);
+  ASSERT_EQ(root->self_allocations, 0);
+  ASSERT_EQ(root->self_allocated_bytes, 0);
+
+  const auto* first = find(prof, 0, 0);
+  ASSERT_NE(first, nullptr);
+  ASSERT_EQ(first->allocations, digits.allocations);
+  ASSERT_EQ(first->self_allocations, digits.allocations);
+  ASSERT_EQ(first->self_allocated_bytes, digits.bytes);
+  const auto* digit = find(prof, 1, 0);
+  ASSERT_NE(digit, nullptr);
+  ASSERT_EQ(digit->allocations, 0);
+  ASSERT_NE(prof.json().find("\"self_allocations\": "), std::string::npos);
+}
+
+TEST(Profiling, ShouldRecordNothingWhenDisabled) {
+  parsers::profile prof;
+  const auto parser =
+      parsers::make_profiled_parser<parsers::interpreters::range_parser, false>(
+          prefixed{}, prof);
+  const auto plain =
+      parsers::interpreters::make_parser<parsers::interpreters::range_parser>(
+          prefixed{});
+  constexpr std::string_view input = "ab";
+  ASSERT_TRUE(parser(input.begin(), input.end()).has_value());
+  ASSERT_TRUE(prof.nodes().empty());
+  ASSERT_EQ(sizeof(parser), sizeof(plain));
+}
@@ -1,7 +1,10 @@
 #include <parsers/parsers.hpp>
 
 #include <gtest/gtest.h>
+#include <cstdint>
 #include <string>
+#include <utility>
+#include <vector>
 
 using namespace parsers::dsl;
 using namespace std::literals::string_literals;
@@ -105,4 +108,23 @@ TEST(RangeParser, RecursiveShouldAggregateResults) {
   static_assert(p2.has_value());
   static_assert(string(p1.value()) == "aaa");
   static_assert(string(p2.value()) == "");
-}
\ No newline at end of file
+}
+TEST(RangeParser, ShouldReportOffsetsIntoContiguousInputs) {
+  constexpr auto number = many1{ascii::digit} & ~('.'_c & many{ascii::digit});
+  constexpr auto p1 = parsers::parse_offsets(number, "12.5 apples");
+  static_assert(p1.has_value());
+  static_assert(p1->first == 0 && p1->second == 4);
+  static_assert(parsers::match_offset(number, "12.5 apples") == 4);
+  static_assert(!parsers::match_offset(number, "x").has_value());
+
+  const std::string text = "3.14";
+  const auto p2 = parsers::parse_offsets(number, text);
+  ASSERT_TRUE(p2.has_value());
+  ASSERT_EQ(p2.value(), (std::pair<std::uint32_t, std::uint32_t>{0, 4}));
+  static_assert(sizeof(p2) == 3 * sizeof(std::uint32_t));
+
+  const std::vector<char> failing{'1', '2', 'x'};
+  const auto p3 = parsers::parse_offsets<std::size_t>(number & 'y'_c, failing);
+  ASSERT_FALSE(p3.has_value());
+  ASSERT_EQ(p3.error(), 2);
+}
@@ -0,0 +1,102 @@
+#include <gtest/gtest.h>
+#include <parsers/allocations.hpp>
+#include <parsers/parsers.hpp>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace parsers::description;
+using namespace std::literals::string_view_literals;
+
+namespace {
+using number = many1<ascii::digit_t>;
+using record = sequence<number, discard<character<','>>, number,
+                        discard<character<'\n'>>>;
+using lines = many<recover<record, character<'\n'>>>;
+}  // namespace
+
+TEST(Recover, ShouldSkipBadRecordsUpToTheSynchronization) {
+  const auto input = "1,2\nx,3\n4,5\n6,\n"sv;
+  parsers::error_log errors;
+  const auto r = parsers::parse_recovering(lines{}, input, errors);
+  ASSERT_TRUE(r.has_value());
+  ASSERT_EQ(r->size(), 4);
+  ASSERT_TRUE(r->at(0).has_value());
+  ASSERT_FALSE(r->at(1).has_value());
+  ASSERT_TRUE(r->at(2).has_value());
+  ASSERT_FALSE(r->at(3).has_value());
+  ASSERT_EQ(std::get<1>(*r->at(2)), std::vector<char>{'5'});
+
+  const std::vector<parsers::parse_error> expected{{4, 0}, {14, 0}};
+  ASSERT_EQ(errors.errors(), expected);
+}
+
+TEST(Recover, ShouldSkipTheSameInputWithEveryInterpreter) {
+  const auto input = "1,2\nx,3\n4,5"sv;
+  ASSERT_TRUE(parsers::match_full(lines{}, input));
+  const auto range = parsers::parse_range(lines{}, input);
+  ASSERT_TRUE(range.has_value());
+  ASSERT_EQ(range->second, input.end());
+  ASSERT_EQ(parsers::parse(lines{}, input)->size(), 3);
+  ASSERT_EQ(parsers::parse_two_phase(lines{}, input)->size(), 3);
+}
+
+TEST(Recover, ShouldReportTheIdOfTheRecover) {
+  const auto input = "12;ab;3;"sv;
+  const auto numbers =
+      many{recover{sequence{number{}, character<';'>{}}, ';', 7}};
+  parsers::error_log errors;
+  const auto r = parsers::parse_recovering(numbers, input, errors);
+  ASSERT_TRUE(r.has_value());
+  ASSERT_EQ(r->size(), 3);
+  ASSERT_EQ(errors.size(), 1);
+  ASSERT_EQ(errors.errors()[0], (parsers::parse_error{3, 7}));
+}
+
+TEST(Recover, ShouldOnlyFailAtTheEndOfTheInput) {
+  parsers::error_log errors;
+  const auto at_end = parsers::parse_recovering(
+      recover<record, character<'\n'>>{}, ""sv, errors);
+  ASSERT_FALSE(at_end.has_value());
+  ASSERT_TRUE(errors.empty());
+
+  const auto unsynchronized = parsers::parse_recovering(lines{}, "1,x"sv, errors);
+  ASSERT_TRUE(unsynchronized.has_value());
+  ASSERT_EQ(unsynchronized->size(), 1);
+  ASSERT_EQ(errors.size(), 1);
+}
+
+TEST(Recover, ShouldNotAllocatePerError) {
+  std::string input;
+  for (int i = 0; i < 100; ++i) {
+    input += "x,1\n";
+  }
+  parsers::error_log errors{16};
+  parsers::allocation_count count;
+  {
+    parsers::count_allocations counting{count};
+    const auto r = parsers::parse_recovering(lines{}, input, errors);
+    ASSERT_EQ(r->size(), 100);
+  }
+  ASSERT_LE(count.allocations, 16);
+  ASSERT_EQ(errors.size(), 16);
+  ASSERT_EQ(errors.dropped(), 84);
+
+  errors.clear();
+  ASSERT_TRUE(errors.empty());
+  ASSERT_EQ(errors.dropped(), 0);
+}
+
+TEST(Recover, ShouldOnlyReportToTheCurrentLog) {
+  const auto input = "1,2\nx,1\n"sv;
+  parsers::error_log errors;
+  {
+    const parsers::collect_errors collecting{errors, input.begin()};
+    ASSERT_TRUE(parsers::match(lines{}, input));
+  }
+  ASSERT_EQ(errors.size(), 1);
+  ASSERT_EQ(errors.errors()[0].offset, 4);
+  ASSERT_TRUE(parsers::match(lines{}, input));
+  ASSERT_EQ(errors.size(), 1);
+}
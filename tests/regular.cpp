@@ -0,0 +1,105 @@
+#include <parsers/parsers.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <string>
+#include <type_traits>
+
+using namespace std::literals::string_literals;
+using namespace parsers::description;
+using parsers::interpreters::make_parser;
+using parsers::interpreters::matcher;
+using parsers::interpreters::object_parser;
+using parsers::interpreters::range_parser;
+
+using number_t =
+    sequence<many1<ascii::digit_t>, character<'.'>, many<ascii::digit_t>>;
+using identifier_t = sequence<alternative<ascii::alpha_t, character<'_'>>,
+                              many<alternative<ascii::alnum_t, character<'_'>>>>;
+
+TEST(Regular, ShouldDetectRegularDescriptions) {
+  static_assert(parsers::regular::is_regular_v<number_t>);
+  static_assert(parsers::regular::is_regular_v<identifier_t>);
+  static_assert(
+      parsers::regular::is_regular_v<either<character<'a'>, ascii::digit_t>>);
+  static_assert(
+      !parsers::regular::is_regular_v<many<sequence<character<'a'>, any_t>>>);
+  static_assert(!parsers::regular::is_regular_v<
+                alternative<character<'a'>, both<character<'b'>, any_t>>>);
+  static_assert(!parsers::regular::is_regular_v<discard<character<'a'>>>);
+}
+
+TEST(Regular, ShouldCompressTheAlphabet) {
+  using automaton = parsers::regular::automaton<identifier_t, char>;
+  static_assert(automaton::class_count == 3);
+  static_assert(automaton::state_count <= 4);
+}
+
+TEST(Regular, ShouldOnlyBeUsedByStructureIndependentInterpreters) {
+  using matcher_parser_t = decltype(make_parser<matcher>(number_t{}));
+  static_assert(std::is_same_v<
+                matcher_parser_t,
+                parsers::regular::detail::automaton_parser<
+                    number_t, parsers::interpreters::make_parser_t<matcher>>>);
+  using object_parser_t = decltype(make_parser<object_parser>(number_t{}));
+  static_assert(!std::is_same_v<
+                object_parser_t,
+                parsers::regular::detail::automaton_parser<
+                    number_t,
+                    parsers::interpreters::make_parser_t<object_parser>>>);
+}
+
+TEST(Regular, ShouldMatchLikeTheCombinators) {
+  static_assert(parsers::match(number_t{}, "12.5"));
+  static_assert(parsers::match(number_t{}, "12."));
+  static_assert(!parsers::match(number_t{}, ".5"));
+  static_assert(!parsers::match(number_t{}, "12"));
+  static_assert(parsers::match_length(identifier_t{}, "_a1") == 3);
+  static_assert(!parsers::match(identifier_t{}, "1a"));
+
+  using possessive_t = sequence<many<character<'a'>>, character<'a'>>;
+  static_assert(!parsers::match(possessive_t{}, "aaa"));
+
+  const auto inputs = {"1.5"s, "12.34x"s, "x1.2"s, "1"s, ""s, "007."s};
+  for (const auto& input : inputs) {
+    const std::u32string wide{input.begin(), input.end()};
+    ASSERT_EQ(parsers::match(number_t{}, input),
+              parsers::match(number_t{}, wide))
+        << input;
+    ASSERT_EQ(parsers::match_length(number_t{}, input),
+              parsers::match_length(number_t{}, wide))
+        << input;
+  }
+}
+
+TEST(Regular, ShouldHandleBytesOutsideAscii) {
+  using latin_t = many1<alternative<character<'\xe9'>, ascii::alpha_t>>;
+  const auto input = "caf\xe9\xff"s;
+  const auto r = parsers::parse_range(latin_t{}, input);
+  ASSERT_TRUE(r.has_value());
+  ASSERT_EQ(r.value().second - r.value().first, 4);
+}
+
+template <class D>
+std::ptrdiff_t failure_position(const std::string& input) {
+  const auto r = parsers::parse_range(D{}, input);
+  EXPECT_TRUE(r.is_error());
+  return r.is_error() ? r.error() - input.begin() : -1;
+}
+
+TEST(Regular, ShouldReportFailuresLikeTheCombinators) {
+  using abc_t = sequence<character<'a'>, character<'b'>, character<'c'>>;
+  using nested_t = sequence<character<'a'>,
+                            sequence<character<'b'>, character<'c'>>,
+                            many<character<'0'>>>;
+  static_assert(parsers::regular::is_regular_v<abc_t>);
+  static_assert(parsers::regular::is_regular_v<nested_t>);
+
+  // The positions reported by the combinators of the unoptimized
+  // descriptions.
+  ASSERT_EQ(failure_position<number_t>("12x"), 2);
+  ASSERT_EQ(failure_position<abc_t>("abd"), 2);
+  ASSERT_EQ(failure_position<nested_t>("aa"), 1);
+  ASSERT_EQ(failure_position<nested_t>("abx"), 1);
+}
@@ -0,0 +1,57 @@
+#include <parsers/parsers.hpp>
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <utility>
+
+using range_result = dpsg::result<std::pair<const char*, const char*>,
+                                  const char*>;
+
+TEST(Result, ShouldStoreIteratorResultsCompactly) {
+  static_assert(range_result::is_compact);
+  static_assert(std::is_trivially_copy_constructible_v<range_result>);
+  static_assert(std::is_trivially_destructible_v<range_result>);
+  static_assert(sizeof(range_result) <= 3 * sizeof(const char*));
+  static_assert(!dpsg::result<std::string, const char*>::is_compact);
+
+  constexpr const char* text = "abc";
+  constexpr range_result success{dpsg::in_place_success, text, text + 2};
+  static_assert(success.has_value());
+  static_assert(success.value().second == text + 2);
+  static_assert(success->first == text);
+  constexpr range_result failure = dpsg::failure(text + 1);
+  static_assert(!failure.has_value());
+  static_assert(failure.error() == text + 1);
+}
+
+TEST(Result, CompactResultsShouldKeepTheResultInterface) {
+  const std::string text = "abc";
+  range_result result{dpsg::in_place_success, text.data(), text.data() + 3};
+  const auto size = result.map([](auto range) {
+    return static_cast<std::size_t>(range.second - range.first);
+  });
+  ASSERT_TRUE(size.has_value());
+  ASSERT_EQ(size.value(), 3);
+
+  result = range_result{dpsg::in_place_error, text.data() + 1};
+  ASSERT_FALSE(result.has_value());
+  ASSERT_EQ(result.error(), text.data() + 1);
+  ASSERT_THROW(static_cast<void>(result.value()), const char*);
+  ASSERT_FALSE(result.map([](auto) { return 0; }).has_value());
+  ASSERT_EQ(result.to_variant().index(), 1);
+
+  result = range_result{dpsg::in_place_success, text.data(), text.data()};
+  ASSERT_TRUE(result.has_value());
+  ASSERT_EQ(result.value().second, text.data());
+}
+
+TEST(Result, InterpretersShouldReturnCompactResults) {
+  const std::string input = "123";
+  const auto range = parsers::parse_range(
+      parsers::description::many1<parsers::description::ascii::digit_t>{},
+      input);
+  static_assert(std::decay_t<decltype(range)>::is_compact);
+  ASSERT_TRUE(range.has_value());
+  ASSERT_EQ(range->second, input.end());
+}
@@ -0,0 +1,117 @@
+#include <parsers/parsers.hpp>
+
+#include <gtest/gtest.h>
+
+#include <iterator>
+#include <string>
+
+using namespace parsers::dsl;
+using namespace parsers::description;
+
+using iterator = std::string::const_iterator;
+
+struct to_int {
+  template <class T>
+  int operator()(const T& digits) const noexcept {
+    int result = 0;
+    for (char c : digits) {
+      result = result * 10 + (c - '0');
+    }
+    return result;
+  }
+};
+
+struct add {
+  template <class T>
+  int operator()(const T& operands) const noexcept {
+    return std::get<0>(operands) + std::get<1>(operands);
+  }
+};
+
+extern const parsers::rule<iterator, int> sum;
+const parsers::rule<iterator, int> number{map{many1{ascii::digit}, to_int{}}};
+const parsers::rule<iterator, int> sum{
+    choose{map{both{ref(number), sequence{discard{'+'_c}, ref(sum)}}, add{}},
+           ref(number)}};
+
+const parsers::rule<iterator> parentheses{
+    either{sequence{'('_c, ref(parentheses), ')'_c}, succeed}};
+
+TEST(Rule, ShouldStoreStatelessDescriptionsInline) {
+  const parsers::rule<iterator> digits{many1{ascii::digit}};
+  ASSERT_TRUE(digits.is_inline());
+  ASSERT_TRUE(parentheses.is_inline());
+
+  const parsers::rule<iterator> words{
+      sequence{"abcdef"_s, "ghijkl"_s, "mn"_s}};
+  ASSERT_FALSE(words.is_inline());
+  ASSERT_TRUE(parsers::match_full(ref(words), std::string{"abcdefghijklmn"}));
+  ASSERT_FALSE(parsers::match_full(ref(words), std::string{"abcdefghijkl"}));
+}
+
+TEST(Rule, ShouldRecurseWithoutFix) {
+  constexpr auto fixed =
+      fix(either{sequence{character<'('>{}, self, character<')'>{}}, succeed});
+  for (std::string input : {"", "()", "(())", "(()", "())", "x"}) {
+    ASSERT_EQ(parsers::match_length(ref(parentheses), input),
+              parsers::match_length(fixed, input))
+        << input;
+    const auto expected = parsers::parse_range(fixed, input);
+    const auto result = parsers::parse_range(ref(parentheses), input);
+    ASSERT_EQ(expected.has_value(), result.has_value()) << input;
+  }
+}
+
+TEST(Rule, ShouldBuildObjects) {
+  ASSERT_EQ(parsers::parse(ref(number), std::string{"42"}).value(), 42);
+  ASSERT_EQ(parsers::parse(ref(sum), std::string{"1+22+300"}).value(), 323);
+  ASSERT_EQ(parsers::parse(ref(sum) & '!'_c, std::string{"1+2!"}).value(),
+            (std::tuple{3, '!'}));
+  ASSERT_FALSE(parsers::parse(ref(sum), std::string{"+1"}).has_value());
+}
+
+TEST(Rule, ShouldBehaveLikeItsDescription) {
+  const auto desc = many1{ascii::digit} & ~('.'_c & many{ascii::digit});
+  const parsers::rule<iterator> erased{desc};
+  for (std::string input : {"12.5", "12", "x", "", "1.", ".5"}) {
+    const auto expected = parsers::parse_range(desc, input);
+    const auto result = parsers::parse_range(ref(erased), input);
+    ASSERT_EQ(expected.has_value(), result.has_value()) << input;
+    if (expected.has_value()) {
+      ASSERT_EQ(expected.value(), result.value()) << input;
+    }
+    else {
+      ASSERT_EQ(expected.error(), result.error()) << input;
+    }
+    ASSERT_EQ(parsers::match(desc, input), parsers::match(ref(erased), input));
+  }
+}
+
+// Counts its copies, each parser built holding one.
+struct copy_counting : satisfy<copy_counting> {
+  int* copies;
+
+  explicit copy_counting(int* c) noexcept : copies{c} {}
+  copy_counting(const copy_counting& other) noexcept : copies{other.copies} {
+    ++*copies;
+  }
+
+  template <class B, class E>
+  B operator()(B begin, E end) const noexcept {
+    return begin != end && *begin == 'x' ? std::next(begin) : begin;
+  }
+};
+
+TEST(Rule, ShouldBuildItsParsersOnce) {
+  int copies = 0;
+  const parsers::rule<iterator> x{copy_counting{&copies}};
+  const int built = copies;
+  for (std::string input : {"x", "y", "xx"}) {
+    ASSERT_EQ(parsers::match(ref(x), input), input[0] == 'x') << input;
+    ASSERT_EQ(parsers::parse_range(ref(x), input).has_value(), input[0] == 'x')
+        << input;
+    ASSERT_EQ(parsers::parse(ref(x), input).has_value(), input[0] == 'x')
+        << input;
+  }
+  ASSERT_EQ(copies, built);
+}
@@ -0,0 +1,133 @@
+#include <parsers/parsers.hpp>
+#include <parsers/runtime/grammar.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using namespace parsers::dsl;
+using namespace parsers::description;
+using parsers::runtime::grammar;
+using parsers::vm::opcode;
+
+template <class D>
+void expect_same_as_range_parser(const char* text,
+                                 const D& desc,
+                                 const std::vector<std::string>& inputs) {
+  const auto g = grammar::load(text);
+  ASSERT_TRUE(g.has_value()) << g.error().message;
+  for (const auto& input : inputs) {
+    const auto expected = parsers::parse_range(desc, input);
+    const auto result = g.value()(input.begin(), input.end());
+    ASSERT_EQ(expected.has_value(), result.has_value()) << input;
+    if (expected.has_value()) {
+      ASSERT_EQ(expected.value(), result.value()) << input;
+    }
+    else {
+      ASSERT_EQ(expected.error(), result.error()) << input;
+    }
+  }
+}
+
+std::ptrdiff_t match_length(const grammar& g, const std::string& input) {
+  const auto result = g(input.begin(), input.end());
+  return result.has_value() ? result.value().second - input.begin() : -1;
+}
+
+TEST(RuntimeGrammar, ShouldMatchLikeCompiledDescriptions) {
+  expect_same_as_range_parser(
+      "number <- [0-9]+ ('.' [0-9]*)?",
+      many1{ascii::digit} & either{'.'_c & many{ascii::digit}, succeed},
+      {"12.5", "12", "x", "", "1.", ".5"});
+  expect_same_as_range_parser(
+      R"g(# comments and spaces are ignored
+         list = '(' [0-9]* ")" ;)g",
+      sequence{'('_c, many{ascii::digit}, ')'_c},
+      {"(12)", "(", "(1x)", "()", " )"});
+  expect_same_as_range_parser(
+      "word <- [^ \\t]+ / '\\t'",
+      many1{ascii::graph} | '\t'_c,
+      {"abc def", "\tx", "", " "});
+}
+
+TEST(RuntimeGrammar, ShouldResolveRuleReferences) {
+  constexpr auto parens =
+      fix(either{sequence{character<'('>{}, self, character<')'>{}}, succeed});
+  expect_same_as_range_parser(
+      "parens <- open parens close / ''\n"
+      "open <- '('\n"
+      "close <- ')'\n",
+      parens,
+      {"(())", "(()", "())", "", "x"});
+}
+
+TEST(RuntimeGrammar, ShouldMatchLiteralAlternativesWithATrie) {
+  const auto g = grammar::load("keyword <- 'let' / 'letter' / 'lex' / 'in'");
+  ASSERT_TRUE(g.has_value());
+  const auto& code = g.value().program().code();
+  ASSERT_TRUE(std::any_of(code.begin(), code.end(), [](auto i) {
+    return i.op == opcode::trie;
+  }));
+  ASSERT_FALSE(std::any_of(code.begin(), code.end(), [](auto i) {
+    return i.op == opcode::choice;
+  }));
+  ASSERT_EQ(match_length(g.value(), "letter"), 3);
+  ASSERT_EQ(match_length(g.value(), "lex"), 3);
+  ASSERT_EQ(match_length(g.value(), "inside"), 2);
+  ASSERT_EQ(match_length(g.value(), "le"), -1);
+  ASSERT_EQ(match_length(g.value(), ""), -1);
+}
+
+TEST(RuntimeGrammar, ShouldSupportPredicates) {
+  const auto g = grammar::load(R"(
+    word <- !keyword [a-z]+ &(' ' / !.)
+    keyword <- 'if' / 'else'
+  )");
+  ASSERT_TRUE(g.has_value());
+  ASSERT_EQ(match_length(g.value(), "iffy"), -1);
+  ASSERT_EQ(match_length(g.value(), "then else"), 4);
+  ASSERT_EQ(match_length(g.value(), "then"), 4);
+  ASSERT_EQ(match_length(g.value(), "else"), -1);
+  ASSERT_EQ(match_length(g.value(), "then1"), -1);
+}
+
+TEST(RuntimeGrammar, ShouldCaptureRangesOfTheInput) {
+  const auto g = grammar::load(R"(
+    assignment <- {name} ' '* '=' ' '* {value}
+    name <- [a-z_]+
+    value <- [0-9]+ / {"'" [^']* "'"}
+  )");
+  ASSERT_TRUE(g.has_value());
+  ASSERT_EQ(g.value().capture_count(), 3);
+
+  const std::string input = "answer = 'forty two'";
+  grammar::captures_t<std::string::const_iterator> captures;
+  ASSERT_TRUE(g.value()(input.begin(), input.end(), captures).has_value());
+  ASSERT_EQ(captures.size(), 3);
+  ASSERT_EQ(std::string(captures[0]->first, captures[0]->second), "answer");
+  ASSERT_EQ(std::string(captures[1]->first, captures[1]->second),
+            "'forty two'");
+  ASSERT_EQ(std::string(captures[2]->first, captures[2]->second),
+            "'forty two'");
+
+  const std::string number = "x=42";
+  ASSERT_TRUE(g.value()(number.begin(), number.end(), captures).has_value());
+  ASSERT_EQ(std::string(captures[1]->first, captures[1]->second), "42");
+  ASSERT_FALSE(captures[2].has_value());
+}
+
+TEST(RuntimeGrammar, ShouldReportLoadErrors) {
+  const auto expect_error = [](const char* text, std::size_t position) {
+    const auto g = grammar::load(text);
+    ASSERT_FALSE(g.has_value()) << text;
+    ASSERT_EQ(g.error().position, position) << g.error().message;
+  };
+  expect_error("a <- 'x", 5);
+  expect_error("a <- b", 5);
+  expect_error("a <- 'x'\nb <- 'y'\na <- 'z'", 18);
+  expect_error("a <- b 'x'\nb <- a", 0);
+  expect_error("a <- 'x' ('y'?)*", 0);
+  expect_error("", 0);
+}
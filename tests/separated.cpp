@@ -0,0 +1,89 @@
+#include <gtest/gtest.h>
+#include <parsers/allocations.hpp>
+#include <parsers/parsers.hpp>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace parsers::description;
+using namespace parsers::dsl;
+using namespace std::literals::string_view_literals;
+
+namespace {
+using number = many1<ascii::digit_t>;
+using numbers = sep_by<number, character<','>>;
+
+struct sum_digits {
+  constexpr int operator()() const noexcept { return 0; }
+  constexpr int operator()(int acc, char c) const noexcept {
+    return acc + (c - '0');
+  }
+};
+}  // namespace
+
+TEST(Separated, ShouldCollectTheElementsInASingleVector) {
+  const auto r = parsers::parse(numbers{}, "12,3,45"sv);
+  ASSERT_TRUE(r.has_value());
+  ASSERT_EQ(r->size(), 3);
+  ASSERT_EQ(r->at(2), (std::vector<char>{'4', '5'}));
+
+  const auto empty = parsers::parse(numbers{}, ""sv);
+  ASSERT_TRUE(empty.has_value());
+  ASSERT_TRUE(empty->empty());
+  ASSERT_FALSE(parsers::match(sep_by1<number, character<','>>{}, ""sv));
+  ASSERT_EQ(parsers::match_length(sep_by1{ascii::digit, ';'}, "1;2;3"sv), 5);
+}
+
+TEST(Separated, ShouldFollowTheTrailingSeparatorPolicy) {
+  constexpr auto input = "1,2,"sv;
+  ASSERT_EQ(parsers::match_length(numbers{}, input), 3);
+  ASSERT_EQ(parsers::match_length(
+                sep_by<number, character<','>, trailing::allowed>{}, input),
+            4);
+  ASSERT_EQ(parsers::match_length(end_by<number, character<','>>{}, input), 4);
+  ASSERT_EQ(parsers::match_length(end_by<number, character<','>>{}, "1,2"sv),
+            2);
+
+  const auto allowed = parsers::parse(
+      sequence{sep_by<number, character<','>, trailing::allowed>{}, end},
+      input);
+  ASSERT_TRUE(allowed.has_value());
+  ASSERT_EQ(allowed->size(), 2);
+  const auto ended = parsers::parse(end_by<number, character<','>>{}, "1,2"sv);
+  ASSERT_EQ(ended->size(), 1);
+
+  const auto range = parsers::parse_range(numbers{}, input);
+  ASSERT_TRUE(range.has_value());
+  ASSERT_EQ(range->second, input.begin() + 3);
+}
+
+TEST(Separated, ShouldOnlyAllocateTheVector) {
+  std::string input = "0";
+  for (int i = 1; i < 200; ++i) {
+    input += ",1";
+  }
+  parsers::allocation_count listed;
+  {
+    parsers::count_allocations counting{listed};
+    ASSERT_EQ(parsers::parse(sep_by{ascii::digit, ','}, input)->size(), 200);
+  }
+  parsers::allocation_count manual;
+  {
+    parsers::count_allocations counting{manual};
+    ASSERT_TRUE(parsers::parse(ascii::digit & many{~character{','} & ascii::digit},
+                               input)
+                    .has_value());
+  }
+  ASSERT_LT(listed.allocations, 10);
+  ASSERT_LE(listed.allocations, manual.allocations);
+}
+
+TEST(Separated, ShouldFoldTheElements) {
+  const auto sum = fold_sep_by{ascii::digit, ',', sum_digits{}};
+  const auto r = parsers::parse(sum, "1,2,3,4"sv);
+  ASSERT_TRUE(r.has_value());
+  ASSERT_EQ(*r, 10);
+  ASSERT_EQ(*parsers::parse(sum, "x"sv), 0);
+  ASSERT_TRUE(parsers::match_full(sum, "1,2,3,4"sv));
+}
@@ -0,0 +1,85 @@
+#include <parsers/parsers.hpp>
+#include <parsers/tokenizer.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+using namespace parsers::dsl;
+using namespace parsers::description;
+
+enum class kind : std::uint8_t { let, identifier, number, equal, plus, end };
+
+const auto lexer = parsers::tokenizer{
+    many{ascii::space},
+    parsers::lexeme{kind::let, "let"_s},
+    parsers::lexeme{kind::identifier, many1<ascii::alpha_t>{}},
+    parsers::lexeme{kind::number, many1{ascii::digit}},
+    parsers::lexeme{kind::equal, '='_c},
+    parsers::lexeme{kind::plus, '+'_c},
+    parsers::lexeme{kind::end, ';'_c}};
+
+std::vector<kind> kinds(std::string_view input) {
+  const auto tokens = lexer(input);
+  std::vector<kind> result;
+  for (const auto& t : tokens.value()) {
+    result.push_back(t.kind);
+  }
+  return result;
+}
+
+TEST(Tokenizer, ShouldSplitTheInputIntoTokens) {
+  constexpr std::string_view input = " let x = 12+y;\n";
+  const auto tokens = lexer(input);
+  ASSERT_TRUE(tokens.has_value());
+  ASSERT_EQ(tokens.value().size(), 7);
+  ASSERT_EQ(tokens.value()[0].kind, kind::let);
+  ASSERT_EQ(tokens.value()[0].offset, 1);
+  ASSERT_EQ(tokens.value()[0].length, 3);
+  ASSERT_EQ(tokens.value()[3].kind, kind::number);
+  ASSERT_EQ(tokens.value()[3].text(input), "12");
+  ASSERT_EQ(tokens.value()[5].text(input), "y");
+  ASSERT_EQ(sizeof(tokens.value()[0]), 12);
+}
+
+TEST(Tokenizer, ShouldPreferTheLongestThenTheFirstLexeme) {
+  ASSERT_EQ(kinds("letter let"), (std::vector{kind::identifier, kind::let}));
+  ASSERT_EQ(kinds("let1"), (std::vector{kind::let, kind::number}));
+  ASSERT_TRUE(kinds("  ").empty());
+}
+
+TEST(Tokenizer, ShouldReportUnknownCharacters) {
+  const auto tokens = lexer(std::string_view{"let x ? 1"});
+  ASSERT_FALSE(tokens.has_value());
+  ASSERT_EQ(tokens.error(), 6);
+}
+
+TEST(Tokenizer, ShouldParseTokensWithCharacterDescriptions) {
+  using operand = either<character<kind::number>, character<kind::identifier>>;
+  constexpr auto statement = sequence{
+      character<kind::let>{},
+      character<kind::identifier>{},
+      character<kind::equal>{},
+      operand{},
+      many{sequence{character<kind::plus>{}, operand{}}},
+      character<kind::end>{}};
+
+  constexpr std::string_view input = "let x = 1 + y + 2; let = 3;";
+  const auto tokens = lexer(input).value();
+  const auto range = parsers::parse_range(statement, tokens);
+  ASSERT_TRUE(range.has_value());
+  ASSERT_EQ(range.value().second - tokens.begin(), 9);
+
+  constexpr auto name_of =
+      discard{character<kind::let>{}} & character<kind::identifier>{};
+  const auto name = parsers::parse(name_of, tokens);
+  ASSERT_TRUE(name.has_value());
+  ASSERT_EQ(name.value().text(input), "x");
+
+  const std::vector rest(tokens.begin() + 9, tokens.end());
+  const auto failure = parsers::parse_range(statement, rest);
+  ASSERT_FALSE(failure.has_value());
+  ASSERT_EQ(failure.error() - rest.begin(), 1);
+}
@@ -0,0 +1,77 @@
+#include <parsers/parsers.hpp>
+#include <parsers/tracing.hpp>
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <string_view>
+
+using namespace parsers::description;
+
+struct nested
+    : recursive<sequence<character<'('>, many<nested>, character<')'>>> {};
+using traced_t = alternative<sequence<character<'a'>, nested>,
+                             sequence<character<'a'>, character<'b'>>>;
+
+TEST(Tracing, ShouldRecordBalancedEventsWithOffsets) {
+  parsers::trace events;
+  const auto parser =
+      parsers::make_traced_parser<parsers::interpreters::range_parser>(
+          traced_t{}, events);
+  constexpr std::string_view input = "ab";
+  ASSERT_TRUE(parser(input.begin(), input.end()).has_value());
+  ASSERT_EQ(events.dropped(), 0);
+  ASSERT_GT(events.size(), 2);
+  ASSERT_EQ(events.size() % 2, 0);
+
+  std::size_t depth = 0;
+  bool failed_after_prefix = false;
+  for (std::size_t i = 0; i < events.size(); ++i) {
+    const auto& e = events[i];
+    if (e.begin) {
+      ++depth;
+    }
+    else {
+      ASSERT_GT(depth, 0);
+      --depth;
+      failed_after_prefix |= !e.success && e.offset == 1;
+    }
+    if (i > 0) {
+      ASSERT_GE(e.timestamp, events[i - 1].timestamp);
+    }
+  }
+  ASSERT_EQ(depth, 0);
+  ASSERT_TRUE(failed_after_prefix);
+  ASSERT_EQ(events[0].offset, 0);
+  ASSERT_TRUE(events[events.size() - 1].success);
+  ASSERT_EQ(events[events.size() - 1].offset, 2);
+}
+
+TEST(Tracing, ShouldOverwriteTheOldestEvents) {
+  parsers::trace events{8};
+  const auto parser =
+      parsers::make_traced_parser<parsers::interpreters::matcher>(nested{},
+                                                                  events);
+  constexpr std::string_view input = "((((()))))";
+  ASSERT_TRUE(parser(input.begin(), input.end()));
+  ASSERT_EQ(events.size(), 8);
+  ASSERT_GT(events.dropped(), 0);
+  ASSERT_FALSE(events[events.size() - 1].begin);
+  ASSERT_EQ(events[events.size() - 1].offset, input.size());
+
+  const auto json = events.chrome_json();
+  ASSERT_EQ(json.find("{\"traceEvents\": ["), 0);
+  ASSERT_NE(json.find("\"ph\": \"E\""), std::string::npos);
+  ASSERT_NE(json.find("\"offset\": 10"), std::string::npos);
+}
+
+TEST(Tracing, ShouldRecordNothingWhenDisabled) {
+  parsers::trace events{4};
+  const auto parser =
+      parsers::make_traced_parser<parsers::interpreters::object_parser, false>(
+          many{ascii::digit}, events);
+  const std::string input = "123";
+  ASSERT_TRUE(parser(input.begin(), input.end()).has_value());
+  ASSERT_EQ(events.size(), 0);
+  ASSERT_EQ(events.chrome_json().find("\"ph\""), std::string::npos);
+}
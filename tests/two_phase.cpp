@@ -0,0 +1,112 @@
+#include <parsers/allocations.hpp>
+#include <parsers/parsers.hpp>
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <string_view>
+
+using namespace parsers::description;
+using namespace std::literals::string_view_literals;
+
+namespace {
+using number = many1<ascii::digit_t>;
+using record =
+    sequence<number, many<sequence<discard<character<','>>, number>>>;
+using records = many<sequence<record, discard<character<'\n'>>>>;
+
+struct list;
+using element = alternative<number, list>;
+struct list : recursive<sequence<character<'['>,
+                                 many<sequence<element, many<character<','>>>>,
+                                 character<']'>>> {};
+
+template <class D>
+void expect_same_as_parse(const D& description, std::string_view input) {
+  const auto expected = parsers::parse(description, input);
+  const auto actual = parsers::parse_two_phase(description, input);
+  ASSERT_EQ(expected.has_value(), actual.has_value()) << input;
+  if (expected.has_value()) {
+    ASSERT_EQ(*expected, *actual) << input;
+  }
+  else {
+    ASSERT_EQ(expected.error(), actual.error()) << input;
+  }
+}
+}  // namespace
+
+TEST(TwoPhase, ShouldProduceTheSameResultsAsParse) {
+  expect_same_as_parse(records{}, "1,22,333\n4\n55,6\n");
+  expect_same_as_parse(records{}, "");
+  expect_same_as_parse(many1<number>{}, "x");
+  expect_same_as_parse(
+      alternative<sequence<many<ascii::alpha_t>, character<'!'>>,
+                  sequence<many<ascii::alpha_t>, many<ascii::digit_t>>>{},
+      "abc123");
+  expect_same_as_parse(map{many{ascii::digit}, [](const auto& v) {
+                             return v.size();
+                           }},
+                       "12345");
+  expect_same_as_parse(sequence<as_range<many<ascii::alpha_t>>, number>{},
+                       "abc12");
+}
+
+TEST(TwoPhase, ShouldHandleRecursiveDescriptions) {
+  const auto input = "[1,[2,3,[]],[[4]],5]"sv;
+  const auto expected = parsers::parse(list{}, input);
+  const auto actual = parsers::parse_two_phase(list{}, input);
+  ASSERT_TRUE(expected.has_value());
+  ASSERT_TRUE(actual.has_value());
+  ASSERT_EQ(std::get<1>(*actual).size(), std::get<1>(*expected).size());
+}
+
+TEST(TwoPhase, ShouldAllocateRepetitionsAtTheirFinalSize) {
+  std::string input;
+  for (int i = 0; i < 1000; ++i) {
+    input += std::to_string(i) + ",";
+  }
+  input += "0\n";
+
+  parsers::allocation_count count;
+  {
+    const parsers::count_allocations counting{count};
+    const auto result = parsers::parse_two_phase(records{}, input);
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(result->size(), 1);
+    const auto& fields = std::get<1>(result->front());
+    ASSERT_EQ(fields.size(), 1000);
+    ASSERT_EQ(fields.capacity(), fields.size());
+  }
+  // The records, the fields, and the digits of each of the 1001 numbers.
+  ASSERT_EQ(count.allocations, 1 + 1 + 1001);
+}
+
+TEST(TwoPhase, ShouldNotBuildAnythingForInvalidInputs) {
+  parsers::allocation_count count;
+  {
+    const parsers::count_allocations counting{count};
+    const auto result = parsers::parse_two_phase(
+        sequence<records, character<'.'>>{}, "1,2,3\n4,5\n"sv);
+    ASSERT_FALSE(result.has_value());
+  }
+  ASSERT_EQ(count.allocations, 0);
+}
+
+TEST(TwoPhase, ShouldRecordSizesInOrder) {
+  parsers::repetition_sizes sizes;
+  ASSERT_TRUE(parsers::parse_two_phase(records{}, "1,22\n3\n"sv, sizes)
+                  .has_value());
+  // records, then for each record its first number, its other fields and
+  // their numbers.
+  ASSERT_EQ(sizes.size(), 6);
+  EXPECT_EQ(sizes[0], 2);
+  EXPECT_EQ(sizes[1], 1);
+  EXPECT_EQ(sizes[2], 1);
+  EXPECT_EQ(sizes[3], 2);
+  EXPECT_EQ(sizes[4], 1);
+  EXPECT_EQ(sizes[5], 0);
+
+  ASSERT_TRUE(
+      parsers::parse_two_phase(records{}, "1\n"sv, sizes).has_value());
+  ASSERT_EQ(sizes.size(), 3);
+}
@@ -0,0 +1,101 @@
+#include <parsers/parsers.hpp>
+#include <parsers/vm.hpp>
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+using namespace std::literals::string_literals;
+using namespace parsers::dsl;
+using namespace parsers::description;
+using parsers::vm::opcode;
+
+template <class D>
+void expect_same_as_range_parser(const D& desc,
+                                 const std::vector<std::string>& inputs) {
+  const auto program = parsers::vm::compile(desc);
+  for (const auto& input : inputs) {
+    const auto expected = parsers::parse_range(desc, input);
+    const auto result = program(input.begin(), input.end());
+    ASSERT_EQ(expected.has_value(), result.has_value()) << input;
+    if (expected.has_value()) {
+      ASSERT_EQ(expected.value(), result.value()) << input;
+    }
+    else {
+      ASSERT_EQ(expected.error(), result.error()) << input;
+    }
+  }
+}
+
+TEST(VM, ShouldCompileCharactersToInstructions) {
+  const auto program =
+      parsers::vm::compile(character<'a'>{} & ascii::digit & "bc");
+  const auto& code = program.code();
+  ASSERT_EQ(code.size(), 7);
+  ASSERT_EQ(code[1].op, opcode::character);
+  ASSERT_EQ(code[3].op, opcode::set);
+  ASSERT_EQ(code[5].op, opcode::string);
+  ASSERT_EQ(program.string(code[5].arg), "bc");
+  ASSERT_EQ(code[6].op, opcode::end);
+}
+
+TEST(VM, ShouldMatchLikeTheRangeParser) {
+  expect_same_as_range_parser(
+      many1{ascii::digit} & ~('.'_c & many{ascii::digit}),
+      {"12.5", "12", "x", "", "1.", ".5"});
+  expect_same_as_range_parser(
+      "let"_s | "letter" | many1{ascii::alpha},
+      {"let", "letter", "lex", "1", ""});
+  expect_same_as_range_parser(at_least{3, ascii::xdigit} & end,
+                              {"abc", "ab", "abcdef", "abg", ""});
+  expect_same_as_range_parser(
+      sequence{many{ascii::space}, '('_c, many{~ascii::digit}, ')'_c},
+      {"  (12)", "(", "(1x)", "()", " )"});
+}
+
+TEST(VM, ShouldSupportRecursion) {
+  constexpr auto parens =
+      fix(either{sequence{character<'('>{}, self, character<')'>{}}, succeed});
+  expect_same_as_range_parser(parens, {"(())", "(()", "())", "", "x"});
+  expect_same_as_range_parser(sequence{character<'x'>{}, parens},
+                              {"x(())", "x(", "y"});
+}
+
+namespace {
+struct rule_z : recursive<either<sequence<character<'z'>, rule_z>, succeed_t>> {
+};
+struct rule_y : recursive<either<sequence<character<'y'>, rule_z>, succeed_t>> {
+};
+struct rule_x : recursive<sequence<character<'x'>, rule_y>> {};
+}  // namespace
+
+TEST(VM, ShouldCompileRulesFoundWhileCompilingRules) {
+  expect_same_as_range_parser(sequence<character<'<'>, rule_x>{},
+                              {"<xyzz", "<x", "<xy", "<xz", "<y", ""});
+}
+
+TEST(VM, ShouldReportCaptures) {
+  parsers::vm::program::set_t letters;
+  for (char c = 'a'; c <= 'z'; ++c) {
+    letters.set(static_cast<unsigned char>(c));
+  }
+
+  parsers::vm::program program;
+  const auto word = program.add_capture();
+  program.emit(opcode::open_capture, word);
+  const auto loop = program.emit(opcode::choice);
+  const auto body = program.emit(opcode::set, program.add_set(letters));
+  program.emit(opcode::partial_commit, body);
+  program.patch(loop, program.emit(opcode::close_capture, word));
+  program.emit(opcode::character, '!');
+  program.emit(opcode::end);
+
+  const auto input = "hello!"s;
+  parsers::vm::program::captures_t<std::string::const_iterator> captures;
+  const auto r = program(input.begin(), input.end(), captures);
+  ASSERT_TRUE(r.has_value());
+  ASSERT_EQ(captures.size(), 1);
+  ASSERT_TRUE(captures[0].has_value());
+  ASSERT_EQ(std::string(captures[0]->first, captures[0]->second), "hello");
+}